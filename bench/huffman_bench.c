@@ -0,0 +1,1175 @@
+/*
+ * File:   huffman_bench.c
+ *
+ * Throughput benchmark and correctness check for the Huffman codec.
+ *
+ *      huffman_bench [--json] [--min-time MS] [--verify]
+ *
+ * Every corpus is generated from a fixed seed, so runs are comparable
+ * over time.  The default output is a table; --json prints one JSON
+ * object per measurement.  --verify only checks the RFC 7541 Appendix C
+ * vectors and round trips every corpus through each API, and exits
+ * non-zero on the first mismatch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "huffman.h"
+#include "hpack.h"
+
+#define BENCH_STRINGS 256               /* Strings per generated corpus */
+#define BENCH_DEFAULT_MIN_MS 200        /* Minimum timed run per measurement */
+#define BENCH_CACHE_SIZE (32 << 20)     /* Large enough to hold every corpus */
+#define BENCH_CODEBOOK_BITS 15          /* Code length limit for the codebook trained on each corpus */
+#define BENCH_FRAME_SIZE (4 << 20)      /* Input for the framed mode */
+#define BENCH_FRAME_THREADS 4           /* Pool workers for the framed mode, besides the caller */
+
+static struct huffman_cache *bench_cache = 0;
+static struct huffman_codebook *bench_hpack_codebook = 0;      /* The HPACK code, loaded as a codebook */
+
+/* Heap calls made by the library, counted through the linker's --wrap */
+#ifdef HUFFMAN_BENCH_COUNT_ALLOCS
+static unsigned long bench_allocs = 0;
+
+void *__real_malloc(size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    bench_allocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    bench_allocs++;
+    return __real_realloc(ptr, size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    bench_allocs++;
+    return __real_calloc(nmemb, size);
+}
+#endif
+
+struct bench_corpus {
+    char name[32];
+    int count;
+    uint8_t *strings[BENCH_STRINGS];
+    int lens[BENCH_STRINGS];
+    uint8_t *encoded[BENCH_STRINGS];
+    int enclens[BENCH_STRINGS];
+    long raw_bytes;
+    long enc_bytes;
+    int max_len;
+    int max_enclen;
+    struct huffman_codebook *cb;        /* Trained on the corpus itself */
+    uint8_t *cb_encoded[BENCH_STRINGS];
+    int cb_enclens[BENCH_STRINGS];
+    long cb_bytes;
+    int max_cb_enclen;
+};
+
+struct bench_result {
+    double ns_per_string;
+    double mb_per_s;
+    double allocs_per_call;             /* Negative when not counted */
+};
+
+static uint64_t bench_seed = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t bench_rand( void ) {
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 7;
+    bench_seed ^= bench_seed << 17;
+    return (uint32_t)(bench_seed >> 16);
+}
+
+static double bench_now( void ) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static unsigned long bench_alloc_count( void ) {
+#ifdef HUFFMAN_BENCH_COUNT_ALLOCS
+    return bench_allocs;
+#else
+    return 0;
+#endif
+}
+
+/******** Corpora ********/
+
+static const char *header_names[] = {
+    ":authority", ":method", ":path", ":scheme", ":status", "accept", "accept-encoding",
+    "accept-language", "cache-control", "content-length", "content-type", "cookie", "date",
+    "etag", "if-modified-since", "if-none-match", "last-modified", "location", "referer",
+    "server", "set-cookie", "strict-transport-security", "user-agent", "vary", "via",
+    "x-forwarded-for", "x-request-id", "access-control-allow-origin", "content-encoding",
+    "sec-fetch-mode", "sec-fetch-site", "sec-ch-ua", "upgrade-insecure-requests", "age",
+    "authorization", "range", "expires", "pragma", "origin", "priority"
+};
+
+static const char *user_agents[] = {
+    "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36",
+    "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/17.4 Safari/605.1.15",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:125.0) Gecko/20100101 Firefox/125.0",
+    "Mozilla/5.0 (iPhone; CPU iPhone OS 17_4 like Mac OS X) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/17.4 Mobile/15E148 Safari/604.1",
+    "Mozilla/5.0 (Linux; Android 14; Pixel 8) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Mobile Safari/537.36",
+    "curl/8.7.1",
+    "okhttp/4.12.0",
+    "Go-http-client/2.0"
+};
+
+static const char base64url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static void bench_corpus_add( struct bench_corpus *c, const uint8_t *s, int len ) {
+    uint8_t *copy = (uint8_t *)malloc(len ? len : 1);
+
+    if (!copy) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    memcpy(copy, s, len);
+    c->strings[c->count] = copy;
+    c->lens[c->count] = len;
+    c->raw_bytes += len;
+    if (len > c->max_len) c->max_len = len;
+    c->count++;
+}
+
+/* Fills 'buf' with 'len' octets of the given flavour */
+static void bench_fill( uint8_t *buf, int len, const char *kind ) {
+    int i = 0, name = 0;
+
+    if (!strcmp(kind, "cookie")) {
+        /* name=value; name=value ... with base64-ish values */
+        while (i < len) {
+            if (i) {
+                buf[i++] = ';';
+                if (i < len) buf[i++] = ' ';
+            }
+            for (name = 3 + bench_rand() % 8; name && i < len; name--) buf[i++] = 'a' + bench_rand() % 26;
+            if (i < len) buf[i++] = '=';
+            for (name = 10 + bench_rand() % 30; name && i < len; name--) buf[i++] = base64url[bench_rand() % 62];
+        }
+    } else if (!strcmp(kind, "token")) {
+        /* JWT-like: three base64url segments */
+        for (i = 0; i < len; i++) {
+            buf[i] = (i == len / 4 || i == (len * 3) / 4) ? '.' : base64url[bench_rand() % 64];
+        }
+        if (len > 3) memcpy(buf, "eyJ", 3);
+    } else {
+        /* Worst case: every octet has a 20-30 bit code */
+        for (i = 0; i < len; i++) buf[i] = (uint8_t)(128 + bench_rand() % 128);
+    }
+}
+
+static void bench_make_corpus( struct bench_corpus *c, const char *kind, int len ) {
+    uint8_t *buf = 0;
+    int i = 0;
+
+    memset(c, 0, sizeof(*c));
+    if (!strcmp(kind, "names")) {
+        snprintf(c->name, sizeof(c->name), "header-names");
+        for (i = 0; i < BENCH_STRINGS; i++) {
+            const char *s = header_names[i % (sizeof(header_names) / sizeof(header_names[0]))];
+            bench_corpus_add(c, (const uint8_t *)s, (int)strlen(s));
+        }
+        return;
+    }
+    if (!strcmp(kind, "ua")) {
+        snprintf(c->name, sizeof(c->name), "user-agents");
+        for (i = 0; i < BENCH_STRINGS; i++) {
+            const char *s = user_agents[i % (sizeof(user_agents) / sizeof(user_agents[0]))];
+            bench_corpus_add(c, (const uint8_t *)s, (int)strlen(s));
+        }
+        return;
+    }
+
+    snprintf(c->name, sizeof(c->name), "%s-%d", kind, len);
+    buf = (uint8_t *)malloc(len);
+    if (!buf) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    for (i = 0; i < BENCH_STRINGS; i++) {
+        bench_fill(buf, len, kind);
+        bench_corpus_add(c, buf, len);
+    }
+    free(buf);
+}
+
+static void bench_encode_corpus( struct bench_corpus *c ) {
+    struct huffman_string in[BENCH_STRINGS];
+    int i = 0;
+
+    for (i = 0; i < c->count; i++) {
+        c->encoded[i] = compress(c->strings[i], c->lens[i], &c->enclens[i]);
+        c->enc_bytes += c->enclens[i];
+        if (c->enclens[i] > c->max_enclen) c->max_enclen = c->enclens[i];
+        in[i].data = c->strings[i];
+        in[i].len = c->lens[i];
+    }
+
+    c->cb = huffman_codebook_train(in, c->count, BENCH_CODEBOOK_BITS);
+    if (!c->cb) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    for (i = 0; i < c->count; i++) {
+        c->cb_enclens[i] = huffman_codebook_encode(c->cb, c->strings[i], c->lens[i], 0, 0);
+        c->cb_encoded[i] = (uint8_t *)malloc(c->cb_enclens[i] + 1);
+        if (!c->cb_encoded[i]) {
+            fprintf(stderr, "huffman_bench: out of memory\n");
+            exit(2);
+        }
+        huffman_codebook_encode(c->cb, c->strings[i], c->lens[i], c->cb_encoded[i], c->cb_enclens[i]);
+        c->cb_bytes += c->cb_enclens[i];
+        if (c->cb_enclens[i] > c->max_cb_enclen) c->max_cb_enclen = c->cb_enclens[i];
+    }
+}
+
+static void bench_free_corpus( struct bench_corpus *c ) {
+    int i = 0;
+
+    for (i = 0; i < c->count; i++) {
+        free(c->strings[i]);
+        free(c->encoded[i]);
+        free(c->cb_encoded[i]);
+    }
+    huffman_codebook_destroy(c->cb);
+}
+
+/******** RFC 7541 Appendix C ********/
+
+static const struct {
+    const char *plain;
+    const char *hex;
+} rfc7541_vectors[] = {
+    { "www.example.com",                "f1e3c2e5f23a6ba0ab90f4ff" },                            /* C.4.1 */
+    { "no-cache",                       "a8eb10649cbf" },                                        /* C.4.2 */
+    { "custom-key",                     "25a849e95ba97d7f" },                                    /* C.4.3 */
+    { "custom-value",                   "25a849e95bb8e8b4bf" },                                  /* C.4.3 */
+    { "302",                            "6402" },                                                /* C.6.1 */
+    { "private",                        "aec3771a4b" },                                          /* C.6.1 */
+    { "Mon, 21 Oct 2013 20:13:21 GMT",  "d07abe941054d444a8200595040b8166e082a62d1bff" },        /* C.6.1 */
+    { "https://www.example.com",        "9d29ad171863c78f0b97c8e9ae82ae43d3" },                  /* C.6.1 */
+    { "307",                            "640eff" },                                              /* C.6.2 */
+    { "Mon, 21 Oct 2013 20:13:22 GMT",  "d07abe941054d444a8200595040b8166e084a62d1bff" },        /* C.6.3 */
+    { "gzip",                           "9bd9ab" },                                              /* C.6.3 */
+    { "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1",
+      "94e7821dd7f2e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007" } /* C.6.3 */
+};
+
+static int bench_unhex( const char *hex, uint8_t *out ) {
+    int n = 0;
+    unsigned int v = 0;
+
+    for (; hex[0] && hex[1]; hex += 2) {
+        if (sscanf(hex, "%2x", &v) != 1) return -1;
+        out[n++] = (uint8_t)v;
+    }
+    return n;
+}
+
+static int bench_check_vectors( void ) {
+    uint8_t expect[64], enc[64];
+    char dec[128];
+    char *out = 0;
+    int i = 0, n = 0, len = 0, failures = 0;
+
+    for (i = 0; i < (int)(sizeof(rfc7541_vectors) / sizeof(rfc7541_vectors[0])); i++) {
+        len = (int)strlen(rfc7541_vectors[i].plain);
+        n = bench_unhex(rfc7541_vectors[i].hex, expect);
+        if (huffman_encode((const uint8_t *)rfc7541_vectors[i].plain, len, enc, sizeof(enc)) != n || memcmp(enc, expect, n)) {
+            fprintf(stderr, "FAIL: encoding \"%s\" does not match RFC 7541\n", rfc7541_vectors[i].plain);
+            failures++;
+        }
+        if (huffman_decode(expect, n, dec, sizeof(dec)) != len || memcmp(dec, rfc7541_vectors[i].plain, len)) {
+            fprintf(stderr, "FAIL: decoding \"%s\" does not match RFC 7541\n", rfc7541_vectors[i].plain);
+            failures++;
+        }
+        out = 0;
+        if (decompress(expect, n, &out, 0) != len || strcmp(out, rfc7541_vectors[i].plain)) {
+            fprintf(stderr, "FAIL: decompress() of \"%s\"\n", rfc7541_vectors[i].plain);
+            failures++;
+        }
+        free(out);
+    }
+    return failures;
+}
+
+/*
+ * RFC 7541 Appendix C.3 to C.6: header lists sent one after the other on
+ * one connection, without and with Huffman coding.  All four sequences
+ * must decode.  hpack_encode() must turn the Huffman ones into blocks of
+ * the same size that decode to the same lists; the octets may differ
+ * where a string is as long Huffman-coded as raw, since the RFC examples
+ * use Huffman then and hpack_encode_string() does not.
+ */
+struct bench_hpack_block {
+    const char *hex;
+    const char *fields[7][2];           /* Name and value, up to a NULL name */
+};
+
+static const struct {
+    const char *name;
+    int table_size;
+    int encode;
+    struct bench_hpack_block block[3];
+} rfc7541_blocks[] = {
+    { "C.3", 4096, 0, {
+        { "828684410f7777772e6578616d706c652e636f6d",
+          { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } } },
+        { "828684be58086e6f2d6361636865",
+          { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" },
+            { "cache-control", "no-cache" } } },
+        { "828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565",
+          { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" },
+            { "custom-key", "custom-value" } } } } },
+    { "C.4", 4096, 1, {
+        { "828684418cf1e3c2e5f23a6ba0ab90f4ff",
+          { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } } },
+        { "828684be5886a8eb10649cbf",
+          { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" },
+            { "cache-control", "no-cache" } } },
+        { "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf",
+          { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" },
+            { "custom-key", "custom-value" } } } } },
+    { "C.5", 256, 0, {
+        { "4803333032580770726976617465611d4d6f6e2c203231204f637420323031332032303a31333a323120474d54"
+          "6e1768747470733a2f2f7777772e6578616d706c652e636f6d",
+          { { ":status", "302" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+            { "location", "https://www.example.com" } } },
+        { "4803333037c1c0bf",
+          { { ":status", "307" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+            { "location", "https://www.example.com" } } },
+        { "88c1611d4d6f6e2c203231204f637420323031332032303a31333a323220474d54c05a04677a69707738666f6f3d"
+          "4153444a4b48514b425a584f5157454f50495541585157454f49553b206d61782d6167653d333630303b2076657273696f6e3d31",
+          { { ":status", "200" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:22 GMT" },
+            { "location", "https://www.example.com" }, { "content-encoding", "gzip" },
+            { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } } } } },
+    { "C.6", 256, 1, {
+        { "488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1bff6e919d29ad171863c78f0b97c8e9ae82ae43d3",
+          { { ":status", "302" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+            { "location", "https://www.example.com" } } },
+        { "4883640effc1c0bf",
+          { { ":status", "307" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+            { "location", "https://www.example.com" } } },
+        { "88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad94e7821dd7f2e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007",
+          { { ":status", "200" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:22 GMT" },
+            { "location", "https://www.example.com" }, { "content-encoding", "gzip" },
+            { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } } } } }
+};
+
+static int bench_same_fields( const struct hpack_header *a, int n, const struct hpack_header *b, int m ) {
+    int i = 0;
+
+    if (n != m) return 0;
+    for (i = 0; i < n; i++) {
+        if (a[i].namelen != b[i].namelen || memcmp(a[i].name, b[i].name, a[i].namelen)
+                || a[i].valuelen != b[i].valuelen || memcmp(a[i].value, b[i].value, a[i].valuelen)) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Checks the RFC 7541 header blocks, then sends a long run of random
+ * header lists through a small table so entries are evicted all the time.
+ */
+static int bench_check_hpack( void ) {
+    static const char *values[] = { "", "0", "gzip", "no-cache", "text/html; charset=utf-8", "https://www.example.com/" };
+    struct hpack_context *enc = 0, *dec = 0, *redec = 0;
+    struct hpack_header want[8], got[8];
+    uint8_t expect[256], block[1024];
+    char buf[1024];
+    int s = 0, b = 0, i = 0, k = 0, n = 0, len = 0, failures = 0;
+
+    for (s = 0; s < (int)(sizeof(rfc7541_blocks) / sizeof(rfc7541_blocks[0])); s++) {
+        enc = hpack_context_create(rfc7541_blocks[s].table_size);
+        dec = hpack_context_create(rfc7541_blocks[s].table_size);
+        redec = hpack_context_create(rfc7541_blocks[s].table_size);
+        for (b = 0; b < 3 && enc && dec && redec; b++) {
+            for (k = 0; rfc7541_blocks[s].block[b].fields[k][0]; k++) {
+                want[k].name = rfc7541_blocks[s].block[b].fields[k][0];
+                want[k].namelen = (int)strlen(want[k].name);
+                want[k].value = rfc7541_blocks[s].block[b].fields[k][1];
+                want[k].valuelen = (int)strlen(want[k].value);
+                want[k].flags = 0;
+            }
+            len = bench_unhex(rfc7541_blocks[s].block[b].hex, expect);
+            n = hpack_decode(dec, expect, len, got, 8, buf, sizeof(buf));
+            if (!bench_same_fields(want, k, got, n)) {
+                fprintf(stderr, "FAIL: hpack_decode() of RFC 7541 %s.%d (%d)\n", rfc7541_blocks[s].name, b + 1, n);
+                failures++;
+            }
+            if (!rfc7541_blocks[s].encode) continue;
+            n = hpack_encode(enc, want, k, block, sizeof(block));
+            if (n != len || !bench_same_fields(want, k, got, hpack_decode(redec, block, n, got, 8, buf, sizeof(buf)))) {
+                fprintf(stderr, "FAIL: hpack_encode() of RFC 7541 %s.%d (%d)\n", rfc7541_blocks[s].name, b + 1, n);
+                failures++;
+            }
+        }
+        hpack_context_destroy(enc);
+        hpack_context_destroy(dec);
+        hpack_context_destroy(redec);
+    }
+
+    enc = hpack_context_create(256);
+    dec = hpack_context_create(256);
+    for (b = 0; b < 20000 && enc && dec && !failures; b++) {
+        if (b % 1000 == 999) hpack_set_max_table_size(enc, (int)(bench_rand() % 257));
+        k = 1 + (int)(bench_rand() % 8);
+        for (i = 0; i < k; i++) {
+            want[i].name = header_names[bench_rand() % (sizeof(header_names) / sizeof(header_names[0]))];
+            want[i].namelen = (int)strlen(want[i].name);
+            want[i].value = values[bench_rand() % (sizeof(values) / sizeof(values[0]))];
+            want[i].valuelen = (int)strlen(want[i].value);
+            want[i].flags = (bench_rand() % 8 == 0) ? HPACK_NEVER_INDEX : 0;
+        }
+        len = hpack_encode(enc, want, k, block, sizeof(block));
+        n = (len < 0) ? len : hpack_decode(dec, block, len, got, 8, buf, sizeof(buf));
+        if (!bench_same_fields(want, k, got, n)) {
+            fprintf(stderr, "FAIL: hpack round trip of block %d (%d)\n", b, n);
+            failures++;
+        }
+        for (i = 0; i < n && !failures; i++) {
+            if ((want[i].flags & HPACK_NEVER_INDEX) != (got[i].flags & HPACK_NEVER_INDEX)) {
+                fprintf(stderr, "FAIL: hpack round trip of block %d lost a never-indexed flag\n", b);
+                failures++;
+            }
+        }
+    }
+    if (!enc || !dec) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        failures++;
+    }
+    hpack_context_destroy(enc);
+    hpack_context_destroy(dec);
+    return failures;
+}
+
+/* Packs 257 code lengths the way huffman_codebook_serialize() does */
+static void bench_pack_lengths( const uint8_t *lengths, uint8_t *out ) {
+    int i = 0, bit = 0;
+
+    memset(out, 0, HUFFMAN_CODEBOOK_SIZE);
+    out[0] = 1;
+    for (i = 0; i < HPACK_SIZE; i++) {
+        for (bit = 4; bit >= 0; bit--) {
+            if ((lengths[i] >> bit) & 1) out[1 + (i * 5 + 4 - bit) / 8] |= 0x80 >> ((i * 5 + 4 - bit) % 8);
+        }
+    }
+}
+
+static int bench_unpack_length( const uint8_t *packed, int symbol ) {
+    int bit = 0, len = 0, pos = 0;
+
+    for (bit = 0; bit < 5; bit++) {
+        pos = symbol * 5 + bit;
+        len = (len << 1) | ((packed[1 + pos / 8] >> (7 - pos % 8)) & 1);
+    }
+    return len;
+}
+
+/*
+ * Loads the HPACK code as a codebook for bench_check_corpus() to compare
+ * with the built-in code, then builds codebooks for every length limit
+ * from a steep histogram and checks the limit, EOS and a round trip.
+ */
+static int bench_check_codebook( void ) {
+    struct huffman_codebook *cb = 0;
+    uint64_t histogram[256];
+    uint8_t lengths[HPACK_SIZE], packed[HUFFMAN_CODEBOOK_SIZE], bad[HUFFMAN_CODEBOOK_SIZE], all[256], enc[256 * 4];
+    char dec[256];
+    int i = 0, bits = 0, longest = 0, n = 0, failures = 0;
+
+    for (i = 0; i < HPACK_SIZE; i++) lengths[i] = (uint8_t)hpack_table[i].bits;
+    bench_pack_lengths(lengths, packed);
+    bench_hpack_codebook = huffman_codebook_load(packed, HUFFMAN_CODEBOOK_SIZE);
+    if (!bench_hpack_codebook || huffman_codebook_serialize(bench_hpack_codebook, bad, sizeof(bad)) != HUFFMAN_CODEBOOK_SIZE
+            || memcmp(bad, packed, HUFFMAN_CODEBOOK_SIZE)) {
+        fprintf(stderr, "FAIL: codebook: the HPACK code lengths do not load and serialize back\n");
+        return 1;
+    }
+
+    /* Truncated, wrong version, incomplete, and EOS not among the longest */
+    memcpy(bad, packed, sizeof(bad));
+    bad[0] = 2;
+    lengths[HPACK_EOS] = 29;
+    if (huffman_codebook_load(packed, HUFFMAN_CODEBOOK_SIZE - 1) || huffman_codebook_load(bad, HUFFMAN_CODEBOOK_SIZE)) failures++;
+    bench_pack_lengths(lengths, bad);
+    if (huffman_codebook_load(bad, HUFFMAN_CODEBOOK_SIZE)) failures++;
+    lengths[HPACK_EOS] = lengths['0'];          /* Swapped with a 5-bit code: still complete */
+    lengths['0'] = 30;
+    bench_pack_lengths(lengths, bad);
+    if (huffman_codebook_load(bad, HUFFMAN_CODEBOOK_SIZE)) failures++;
+    if (failures) fprintf(stderr, "FAIL: codebook: huffman_codebook_load() accepted a bad codebook\n");
+
+    memset(histogram, 0, sizeof(histogram));
+    if (huffman_codebook_build(histogram, HUFFMAN_CODEBOOK_MIN_BITS - 1) || huffman_codebook_build(histogram, HUFFMAN_CODEBOOK_MAX_BITS + 1)) {
+        fprintf(stderr, "FAIL: codebook: huffman_codebook_build() accepted a bad length limit\n");
+        failures++;
+    }
+    for (i = 0; i < 256; i++) {
+        histogram[i] = (uint64_t)1 << (i % 48);
+        all[i] = (uint8_t)i;
+    }
+    for (bits = HUFFMAN_CODEBOOK_MIN_BITS; bits <= HUFFMAN_CODEBOOK_MAX_BITS && !failures; bits++) {
+        cb = huffman_codebook_build(histogram, bits);
+        if (!cb || huffman_codebook_serialize(cb, packed, sizeof(packed)) != HUFFMAN_CODEBOOK_SIZE) {
+            fprintf(stderr, "FAIL: codebook: no codebook for %d bits\n", bits);
+            failures++;
+            break;
+        }
+        for (i = 0, longest = 0; i < HPACK_SIZE; i++) {
+            if (bench_unpack_length(packed, i) > longest) longest = bench_unpack_length(packed, i);
+        }
+        n = huffman_codebook_encode(cb, all, 256, enc, sizeof(enc));
+        if (longest > bits || bench_unpack_length(packed, HPACK_EOS) != longest
+                || n < 0 || n > (int)sizeof(enc) || huffman_codebook_decode(cb, enc, n, dec, 256) != 256 || memcmp(dec, all, 256)) {
+            fprintf(stderr, "FAIL: codebook: %d-bit codebook breaks its limit or the round trip\n", bits);
+            failures++;
+        }
+        huffman_codebook_destroy(cb);
+    }
+    return failures;
+}
+
+/* Standard check values of the hashes, and fields for each check */
+static const struct {
+    const char *text;
+    int validate;
+    int hash;
+    uint64_t hash_value;
+    int rc;                                     /* Expected result: the length when >= 0 */
+    int error_offset;
+} bench_checked[] = {
+    { "a", 0, HUFFMAN_HASH_FNV1A_32, 0xe40c292cULL, 1, -1 },
+    { "a", 0, HUFFMAN_HASH_FNV1A_64, 0xaf63dc4c8601ec8cULL, 1, -1 },
+    { "123456789", 0, HUFFMAN_HASH_CRC32C, 0xe3069283ULL, 9, -1 },
+    { "", 0, HUFFMAN_HASH_FNV1A_64, 0xcbf29ce484222325ULL, 0, -1 },
+    { "content-type", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, 12, -1 },
+    { ":path", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, 5, -1 },
+    { "Content-Type", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, HUFFMAN_NAME_UPPERCASE, 0 },
+    { "x-a:b", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, HUFFMAN_NAME_INVALID, 3 },
+    { "x b", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, HUFFMAN_NAME_INVALID, 1 },
+    { "", HUFFMAN_VALIDATE_NAME, HUFFMAN_HASH_NONE, 0, HUFFMAN_NAME_INVALID, 0 },
+    { "text/html; q=0.9", HUFFMAN_VALIDATE_VALUE, HUFFMAN_HASH_NONE, 0, 16, -1 },
+    { " x", HUFFMAN_VALIDATE_VALUE, HUFFMAN_HASH_NONE, 0, HUFFMAN_VALUE_INVALID, 0 },
+    { "x\t", HUFFMAN_VALIDATE_VALUE, HUFFMAN_HASH_NONE, 0, HUFFMAN_VALUE_INVALID, 1 },
+    { "ab\r\nc", HUFFMAN_VALIDATE_VALUE, HUFFMAN_HASH_NONE, 0, HUFFMAN_VALUE_INVALID, 2 }
+};
+
+/*
+ * Checked decoding: hashes against their standard check values, name and
+ * value rules, and the RFC 7541 endings the plain decoder lets through.
+ */
+static int bench_check_checked( void ) {
+    static const struct {
+        const char *hex;
+        int rc;
+    } endings[] = {
+        { "1f", 1 },                            /* "a" and 3 bits of padding */
+        { "18", HUFFMAN_PADDING_INVALID },
+        { "1fff", HUFFMAN_PADDING_TOO_LONG },
+        { "ffffffff", HUFFMAN_EOS_DECODED }
+    };
+    struct huffman_check check;
+    struct huffman_stats before, after;
+    uint64_t expected[HUFFMAN_STATS_ERRORS] = { 0 };
+    uint8_t enc[64];
+    char dec[64];
+    int i = 0, n = 0, rc = 0, failures = 0, counting = 0;
+
+    counting = (huffman_get_stats(&before) == HUFFMAN_SUCCESS);
+    for (i = 0; i < (int)(sizeof(bench_checked) / sizeof(bench_checked[0])); i++) {
+        n = huffman_encode((const uint8_t *)bench_checked[i].text, (int)strlen(bench_checked[i].text), enc, sizeof(enc));
+        memset(&check, 0, sizeof(check));
+        check.validate = bench_checked[i].validate;
+        check.hash = bench_checked[i].hash;
+        rc = huffman_decode_checked(enc, n, dec, sizeof(dec), &check);
+        if (rc != bench_checked[i].rc || check.error_offset != bench_checked[i].error_offset || check.hash_value != bench_checked[i].hash_value
+                || (rc >= 0 && memcmp(dec, bench_checked[i].text, rc))) {
+            fprintf(stderr, "FAIL: huffman_decode_checked(\"%s\") = %d at %d, hash %llx\n", bench_checked[i].text, rc,
+                    check.error_offset, (unsigned long long)check.hash_value);
+            failures++;
+        }
+        if (bench_checked[i].rc < 0) expected[-bench_checked[i].rc]++;
+    }
+    
+    /* With HUFFMAN_STATS, every failure is counted by kind */
+    if (counting && huffman_get_stats(&after) == HUFFMAN_SUCCESS) {
+        for (i = 1; i < HUFFMAN_STATS_ERRORS; i++) {
+            if (after.errors[i] - before.errors[i] != expected[i]) {
+                fprintf(stderr, "FAIL: huffman_get_stats() counted %llu errors %d, not %llu\n",
+                        (unsigned long long)(after.errors[i] - before.errors[i]), -i, (unsigned long long)expected[i]);
+                failures++;
+            }
+        }
+    }
+    for (i = 0; i < (int)(sizeof(endings) / sizeof(endings[0])); i++) {
+        n = bench_unhex(endings[i].hex, enc);
+        memset(&check, 0, sizeof(check));
+        if (huffman_decode_checked(enc, n, 0, 0, &check) != endings[i].rc) {
+            fprintf(stderr, "FAIL: huffman_decode_checked(%s) does not return %d\n", endings[i].hex, endings[i].rc);
+            failures++;
+        }
+    }
+    memset(&check, 0, sizeof(check));
+    check.hash = 4;
+    if (huffman_decode_checked(enc, 1, dec, sizeof(dec), &check) != HUFFMAN_BAD_PARAMETER) failures++;
+    return failures;
+}
+
+/* A large cookie-like buffer for the framed mode; the caller frees it */
+static uint8_t *bench_make_frame_input( int len ) {
+    uint8_t *buf = (uint8_t *)malloc(len);
+    int i = 0;
+
+    if (!buf) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    for (i = 0; i < len; i += 1024) bench_fill(buf + i, (len - i < 1024) ? len - i : 1024, "cookie");
+    return buf;
+}
+
+/*
+ * Frames with and without a pool must be identical and decode back, one
+ * block at a time as well as whole; damaged frames must be refused.
+ */
+static int bench_check_frame( void ) {
+    static const int sizes[] = { 0, 1, 1000, 65536, 300001 };
+    struct huffman_pool *pool = huffman_pool_create(BENCH_FRAME_THREADS);
+    struct huffman_frame_info info;
+    struct huffman_stats before, after;
+    uint8_t *input = bench_make_frame_input(sizes[4]), *serial = 0, *framed = 0;
+    char *dec = (char *)malloc(sizes[4] + 1);
+    int s = 0, b = 0, n = 0, m = 0, block_size = 0, failures = 0, counting = 0;
+
+    serial = (uint8_t *)malloc(2 * sizes[4] + HUFFMAN_FRAME_HEADER + 4096);
+    framed = (uint8_t *)malloc(2 * sizes[4] + HUFFMAN_FRAME_HEADER + 4096);
+    if (!pool || !dec || !serial || !framed) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+
+    for (s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])) && !failures; s++) {
+        block_size = s ? sizes[s] / 3 + 1 : HUFFMAN_FRAME_BLOCK_SIZE;
+        n = huffman_frame_encode(0, 0, input, sizes[s], block_size, 0, 0);
+        if (n < HUFFMAN_FRAME_HEADER || huffman_frame_encode(0, 0, input, sizes[s], block_size, serial, n) != n
+                || huffman_frame_encode(pool, 0, input, sizes[s], block_size, framed, n) != n || memcmp(serial, framed, n)) {
+            fprintf(stderr, "FAIL: frame-%d: pooled frame differs from the serial one\n", sizes[s]);
+            failures++;
+            break;
+        }
+        if (huffman_frame_info(framed, n, &info) != HUFFMAN_SUCCESS || info.length != sizes[s]
+                || info.frame_length != n || info.block_size != block_size) {
+            fprintf(stderr, "FAIL: frame-%d: huffman_frame_info()\n", sizes[s]);
+            failures++;
+        }
+        if (huffman_frame_decode(pool, 0, framed, n, dec, sizes[s]) != sizes[s] || memcmp(dec, input, sizes[s])) {
+            fprintf(stderr, "FAIL: frame-%d: huffman_frame_decode() round trip\n", sizes[s]);
+            failures++;
+        }
+        for (b = info.blocks - 1; b >= 0 && !failures; b--) {
+            m = huffman_frame_decode_block(0, framed, n, b, dec, block_size);
+            if (m < 0 || memcmp(dec, input + b * block_size, m) || b * block_size + m > sizes[s]) {
+                fprintf(stderr, "FAIL: frame-%d: huffman_frame_decode_block(%d)\n", sizes[s], b);
+                failures++;
+            }
+        }
+    }
+
+    /* Damage: magic, a truncated index, an index entry past the end, and a short block */
+    n = huffman_frame_encode(pool, 0, input, sizes[3], 1000, framed, 2 * sizes[4]);
+    memcpy(serial, framed, n);
+    counting = (huffman_get_stats(&before) == HUFFMAN_SUCCESS);
+    serial[0] ^= 1;
+    if (huffman_frame_decode(pool, 0, serial, n, dec, sizes[3]) != HUFFMAN_FRAME_INVALID) failures++;
+    if (huffman_frame_decode(pool, 0, framed, HUFFMAN_FRAME_HEADER + 8, dec, sizes[3]) != HUFFMAN_FRAME_INVALID) failures++;
+    memcpy(serial, framed, n);
+    serial[HUFFMAN_FRAME_HEADER + 8 * 65 + 1] ^= 0x40;
+    if (huffman_frame_decode(pool, 0, serial, n, dec, sizes[3]) != HUFFMAN_FRAME_INVALID) failures++;
+    if (counting && huffman_get_stats(&after) == HUFFMAN_SUCCESS
+            && after.errors[-HUFFMAN_FRAME_INVALID] - before.errors[-HUFFMAN_FRAME_INVALID] != 3) {
+        fprintf(stderr, "FAIL: frame: huffman_get_stats() missed damaged frames\n");
+        failures++;
+    }
+    memcpy(serial, framed, n);
+    serial[HUFFMAN_FRAME_HEADER + 8 * 10 + 3] -= 1;                     /* Block 10 loses an octet to block 11 */
+    if (huffman_frame_decode_block(0, serial, n, 10, dec, 1000) != HUFFMAN_FRAME_INVALID
+            || huffman_frame_decode(pool, 0, serial, n, dec, sizes[3]) != HUFFMAN_FRAME_INVALID) failures++;
+    if (huffman_frame_decode_block(0, framed, n, 66, dec, 1000) != HUFFMAN_BAD_PARAMETER) failures++;
+    if (failures) fprintf(stderr, "FAIL: frame: a damaged frame was accepted\n");
+
+    huffman_pool_destroy(pool);
+    free(input);
+    free(dec);
+    free(serial);
+    free(framed);
+    return failures;
+}
+
+/* Times framed encode and decode of BENCH_FRAME_SIZE octets, without and with a pool */
+static void bench_measure_frame( double min_time, int json ) {
+    struct huffman_pool *pool = huffman_pool_create(BENCH_FRAME_THREADS);
+    uint8_t *input = bench_make_frame_input(BENCH_FRAME_SIZE), *framed = 0;
+    char *dec = (char *)malloc(BENCH_FRAME_SIZE);
+    char op[32];
+    double start = 0, elapsed = 0, ns = 0, mbs = 0;
+    long calls = 0;
+    int n = huffman_frame_encode(0, 0, input, BENCH_FRAME_SIZE, HUFFMAN_FRAME_BLOCK_SIZE, 0, 0), k = 0, decoding = 0;
+
+    framed = (uint8_t *)malloc(n);
+    if (!pool || !dec || !framed) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    huffman_frame_encode(0, 0, input, BENCH_FRAME_SIZE, HUFFMAN_FRAME_BLOCK_SIZE, framed, n);
+
+    for (decoding = 0; decoding < 2; decoding++) {
+        for (k = 0; k < 2; k++) {
+            start = bench_now();
+            calls = 0;
+            do {
+                if (decoding) huffman_frame_decode(k ? pool : 0, 0, framed, n, dec, BENCH_FRAME_SIZE);
+                else huffman_frame_encode(k ? pool : 0, 0, input, BENCH_FRAME_SIZE, HUFFMAN_FRAME_BLOCK_SIZE, framed, n);
+                calls++;
+                elapsed = bench_now() - start;
+            } while (elapsed < min_time);
+            ns = elapsed * 1e9 / (double)calls;
+            mbs = (double)calls * BENCH_FRAME_SIZE / elapsed / 1e6;
+            snprintf(op, sizeof(op), "huffman_frame_%s/%d", decoding ? "decode" : "encode", k ? BENCH_FRAME_THREADS + 1 : 1);
+            if (json) {
+                printf("{\"corpus\":\"frame-%d\",\"op\":\"%s\",\"strings\":1,\"avg_len\":%d.0,\"ratio\":%.4f,"
+                       "\"ns_per_string\":%.2f,\"mb_per_s\":%.2f,\"allocs_per_call\":null}\n",
+                       BENCH_FRAME_SIZE, op, BENCH_FRAME_SIZE, (double)n / BENCH_FRAME_SIZE, ns, mbs);
+            } else {
+                printf("frame-%-10d %-26s %8d %6.3f %12.1f %10.1f %12s\n", BENCH_FRAME_SIZE, op, BENCH_FRAME_SIZE, (double)n / BENCH_FRAME_SIZE, ns, mbs, "n/a");
+            }
+        }
+    }
+    huffman_pool_destroy(pool);
+    free(input);
+    free(dec);
+    free(framed);
+}
+
+/* Round trips a corpus through every encode and decode entry point */
+static int bench_check_corpus( struct bench_corpus *c ) {
+    struct huffman_string in[BENCH_STRINGS];
+    struct huffman_codebook *cb = 0;
+    struct huffman_check check;
+    struct huffman_decoder d;
+    uint64_t fnv = 0;
+    int offsets[BENCH_STRINGS + 1];
+    uint8_t *enc = 0;
+    char *dec = 0, *out = 0;
+    int i = 0, j = 0, n = 0, h = 0, total = 0, failures = 0;
+
+    enc = (uint8_t *)malloc(c->enc_bytes + c->max_len + c->max_cb_enclen + HUFFMAN_CODEBOOK_SIZE);
+    dec = (char *)malloc(c->raw_bytes + HUFFMAN_DECODER_BOUND(1) + 1);
+    if (!enc || !dec) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+
+    for (i = 0; i < c->count && !failures; i++) {
+        if (huffman_encode(c->strings[i], c->lens[i], enc, c->max_enclen) != c->enclens[i]
+                || memcmp(enc, c->encoded[i], c->enclens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_encode() differs from compress()\n", c->name, i);
+            failures++;
+        }
+        if (huffman_decode(c->encoded[i], c->enclens[i], dec, c->max_len) != c->lens[i]
+                || memcmp(dec, c->strings[i], c->lens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_decode() round trip\n", c->name, i);
+            failures++;
+        }
+        if (huffman_encoded_length(c->strings[i], c->lens[i], -1) != c->enclens[i]
+                || huffman_encoded_length(c->strings[i], c->lens[i], c->enclens[i]) != c->enclens[i]
+                || (c->enclens[i] && huffman_encoded_length(c->strings[i], c->lens[i], c->enclens[i] - 1) != c->enclens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_encoded_length() differs from compress()\n", c->name, i);
+            failures++;
+        }
+        n = huffman_encode_if_shorter(c->strings[i], c->lens[i], enc, c->max_len + c->max_enclen, &h);
+        if (h != (c->enclens[i] < c->lens[i]) || n != (h ? c->enclens[i] : c->lens[i])
+                || memcmp(enc, h ? c->encoded[i] : c->strings[i], n)) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_encode_if_shorter() picked the wrong form\n", c->name, i);
+            failures++;
+        }
+        for (j = 0; j < 2; j++) {             /* A miss, then a hit */
+            if (huffman_cache_encode(bench_cache, c->strings[i], c->lens[i], enc, c->max_enclen) != c->enclens[i]
+                    || memcmp(enc, c->encoded[i], c->enclens[i])) {
+                fprintf(stderr, "FAIL: %s[%d]: huffman_cache_encode() differs from compress()\n", c->name, i);
+                failures++;
+            }
+            if (huffman_cache_decode(bench_cache, c->encoded[i], c->enclens[i], dec, c->max_len) != c->lens[i]
+                    || memcmp(dec, c->strings[i], c->lens[i])) {
+                fprintf(stderr, "FAIL: %s[%d]: huffman_cache_decode() round trip\n", c->name, i);
+                failures++;
+            }
+        }
+        if (huffman_codebook_decode(c->cb, c->cb_encoded[i], c->cb_enclens[i], dec, c->max_len) != c->lens[i]
+                || memcmp(dec, c->strings[i], c->lens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_codebook_decode() round trip\n", c->name, i);
+            failures++;
+        }
+        if (huffman_codebook_encode(bench_hpack_codebook, c->strings[i], c->lens[i], enc, c->max_enclen) != c->enclens[i]
+                || memcmp(enc, c->encoded[i], c->enclens[i])
+                || huffman_codebook_decode(bench_hpack_codebook, c->encoded[i], c->enclens[i], dec, c->max_len) != c->lens[i]
+                || memcmp(dec, c->strings[i], c->lens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: the HPACK code as a codebook differs from compress()\n", c->name, i);
+            failures++;
+        }
+        memset(&check, 0, sizeof(check));
+        check.hash = HUFFMAN_HASH_FNV1A_64;
+        for (j = 0, fnv = 0xcbf29ce484222325ULL; j < c->lens[i]; j++) fnv = (fnv ^ c->strings[i][j]) * 0x100000001b3ULL;
+        if (huffman_decode_checked(c->encoded[i], c->enclens[i], dec, c->max_len, &check) != c->lens[i]
+                || memcmp(dec, c->strings[i], c->lens[i]) || check.hash_value != fnv) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_decode_checked() round trip\n", c->name, i);
+            failures++;
+        }
+        out = 0;
+        if (decompress(c->encoded[i], c->enclens[i], &out, 0) != c->lens[i] || memcmp(out, c->strings[i], c->lens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: decompress() round trip\n", c->name, i);
+            failures++;
+        }
+        free(out);
+
+        /* One octet at a time through the streaming decoder */
+        huffman_decoder_init(&d);
+        for (j = 0, total = 0; j < c->enclens[i]; j++) {
+            n = huffman_decoder_feed(&d, c->encoded[i] + j, 1, dec + total, HUFFMAN_DECODER_BOUND(1));
+            if (n < 0) break;
+            total += n;
+        }
+        if (n < 0 || huffman_decoder_finish(&d) != HUFFMAN_SUCCESS || total != c->lens[i] || memcmp(dec, c->strings[i], total)) {
+            fprintf(stderr, "FAIL: %s[%d]: streaming decoder round trip\n", c->name, i);
+            failures++;
+        }
+    }
+
+    /* A serialized and reloaded codebook codes exactly like the original */
+    if (huffman_codebook_serialize(c->cb, enc, HUFFMAN_CODEBOOK_SIZE) != HUFFMAN_CODEBOOK_SIZE
+            || !(cb = huffman_codebook_load(enc, HUFFMAN_CODEBOOK_SIZE))) {
+        fprintf(stderr, "FAIL: %s: huffman_codebook_load() rejects a serialized codebook\n", c->name);
+        failures++;
+    }
+    for (i = 0; i < c->count && cb && !failures; i++) {
+        if (huffman_codebook_encode(cb, c->strings[i], c->lens[i], enc, c->max_cb_enclen) != c->cb_enclens[i]
+                || memcmp(enc, c->cb_encoded[i], c->cb_enclens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: reloaded codebook differs from the original\n", c->name, i);
+            failures++;
+        }
+    }
+    huffman_codebook_destroy(cb);
+
+    for (i = 0; i < c->count; i++) {
+        in[i].data = c->strings[i];
+        in[i].len = c->lens[i];
+    }
+    if (huffman_encode_batch(in, c->count, enc, (int)c->enc_bytes, offsets) != c->enc_bytes) {
+        fprintf(stderr, "FAIL: %s: huffman_encode_batch() size\n", c->name);
+        failures++;
+    }
+    for (i = 0; i < c->count && !failures; i++) {
+        if (offsets[i+1] - offsets[i] != c->enclens[i] || memcmp(enc + offsets[i], c->encoded[i], c->enclens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_encode_batch() differs from compress()\n", c->name, i);
+            failures++;
+        }
+        in[i].data = c->encoded[i];
+        in[i].len = c->enclens[i];
+    }
+    if (!failures && huffman_decode_batch(in, c->count, dec, (int)c->raw_bytes, offsets) != c->raw_bytes) {
+        fprintf(stderr, "FAIL: %s: huffman_decode_batch() size\n", c->name);
+        failures++;
+    }
+    for (i = 0; i < c->count && !failures; i++) {
+        if (offsets[i+1] - offsets[i] != c->lens[i] || memcmp(dec + offsets[i], c->strings[i], c->lens[i])) {
+            fprintf(stderr, "FAIL: %s[%d]: huffman_decode_batch() round trip\n", c->name, i);
+            failures++;
+        }
+    }
+
+    free(enc);
+    free(dec);
+    return failures;
+}
+
+/******** Measurements ********/
+
+enum bench_op {
+    BENCH_COMPRESS,
+    BENCH_ENCODE_INTO,
+    BENCH_ENCODE_BATCH,
+    BENCH_ENCODED_LENGTH,
+    BENCH_ENCODE_IF_SHORTER,
+    BENCH_CACHE_ENCODE,
+    BENCH_CODEBOOK_ENCODE,
+    BENCH_DECOMPRESS,
+    BENCH_DECODE_INTO,
+    BENCH_DECODE_BATCH,
+    BENCH_CACHE_DECODE,
+    BENCH_CODEBOOK_DECODE,
+    BENCH_DECODE_CHECKED,
+    BENCH_OPS
+};
+
+static const char *bench_op_names[BENCH_OPS] = {
+    "compress", "huffman_encode", "huffman_encode_batch",
+    "huffman_encoded_length", "huffman_encode_if_shorter", "huffman_cache_encode",
+    "huffman_codebook_encode",
+    "decompress", "huffman_decode", "huffman_decode_batch", "huffman_cache_decode",
+    "huffman_codebook_decode", "huffman_decode_checked"
+};
+
+/* One pass over the corpus; returns the number of library calls made */
+static int bench_pass( struct bench_corpus *c, enum bench_op op, uint8_t *ebuf, char *dbuf, struct huffman_string *in, int *offsets ) {
+    struct huffman_check check;
+    uint8_t *enc = 0;
+    char *out = 0;
+    int i = 0, len = 0, h = 0;
+
+    switch (op) {
+    case BENCH_COMPRESS:
+        for (i = 0; i < c->count; i++) {
+            enc = compress(c->strings[i], c->lens[i], &len);
+            free(enc);
+        }
+        return c->count;
+    case BENCH_ENCODE_INTO:
+        for (i = 0; i < c->count; i++) huffman_encode(c->strings[i], c->lens[i], ebuf, c->max_enclen);
+        return c->count;
+    case BENCH_ENCODE_BATCH:
+        huffman_encode_batch(in, c->count, ebuf, (int)c->enc_bytes, offsets);
+        return 1;
+    case BENCH_ENCODED_LENGTH:
+        for (i = 0; i < c->count; i++) huffman_encoded_length(c->strings[i], c->lens[i], -1);
+        return c->count;
+    case BENCH_ENCODE_IF_SHORTER:
+        for (i = 0; i < c->count; i++) huffman_encode_if_shorter(c->strings[i], c->lens[i], ebuf, c->max_len + c->max_enclen, &h);
+        return c->count;
+    case BENCH_CACHE_ENCODE:
+        for (i = 0; i < c->count; i++) huffman_cache_encode(bench_cache, c->strings[i], c->lens[i], ebuf, c->max_enclen);
+        return c->count;
+    case BENCH_CODEBOOK_ENCODE:
+        for (i = 0; i < c->count; i++) huffman_codebook_encode(c->cb, c->strings[i], c->lens[i], ebuf, c->max_cb_enclen);
+        return c->count;
+    case BENCH_DECOMPRESS:
+        for (i = 0; i < c->count; i++) {
+            out = 0;
+            decompress(c->encoded[i], c->enclens[i], &out, 0);
+            free(out);
+        }
+        return c->count;
+    case BENCH_DECODE_INTO:
+        for (i = 0; i < c->count; i++) huffman_decode(c->encoded[i], c->enclens[i], dbuf, c->max_len);
+        return c->count;
+    case BENCH_DECODE_BATCH:
+        huffman_decode_batch(in, c->count, dbuf, (int)c->raw_bytes, offsets);
+        return 1;
+    case BENCH_CACHE_DECODE:
+        for (i = 0; i < c->count; i++) huffman_cache_decode(bench_cache, c->encoded[i], c->enclens[i], dbuf, c->max_len);
+        return c->count;
+    case BENCH_CODEBOOK_DECODE:
+        for (i = 0; i < c->count; i++) huffman_codebook_decode(c->cb, c->cb_encoded[i], c->cb_enclens[i], dbuf, c->max_len);
+        return c->count;
+    case BENCH_DECODE_CHECKED:
+        memset(&check, 0, sizeof(check));
+        check.validate = HUFFMAN_VALIDATE_VALUE;
+        check.hash = HUFFMAN_HASH_FNV1A_64;
+        for (i = 0; i < c->count; i++) huffman_decode_checked(c->encoded[i], c->enclens[i], dbuf, c->max_len, &check);
+        return c->count;
+    default:
+        return 0;
+    }
+}
+
+static void bench_measure( struct bench_corpus *c, enum bench_op op, double min_time, struct bench_result *r ) {
+    struct huffman_string in[BENCH_STRINGS];
+    int offsets[BENCH_STRINGS + 1];
+    uint8_t *ebuf = (uint8_t *)malloc(c->enc_bytes + c->max_len + c->max_cb_enclen + 1);
+    char *dbuf = (char *)malloc(c->raw_bytes + 1);
+    unsigned long allocs = 0;
+    long passes = 0, calls = 0;
+    double start = 0, elapsed = 0;
+    int i = 0, decoding = (op >= BENCH_DECOMPRESS);
+
+    if (!ebuf || !dbuf) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        exit(2);
+    }
+    for (i = 0; i < c->count; i++) {
+        in[i].data = decoding ? c->encoded[i] : c->strings[i];
+        in[i].len = decoding ? c->enclens[i] : c->lens[i];
+    }
+
+    bench_pass(c, op, ebuf, dbuf, in, offsets);      /* Warm up */
+    allocs = bench_alloc_count();
+    start = bench_now();
+    do {
+        calls += bench_pass(c, op, ebuf, dbuf, in, offsets);
+        passes++;
+        elapsed = bench_now() - start;
+    } while (elapsed < min_time);
+    allocs = bench_alloc_count() - allocs;
+
+    r->ns_per_string = elapsed * 1e9 / ((double)passes * c->count);
+    r->mb_per_s = ((double)passes * c->raw_bytes) / elapsed / 1e6;
+#ifdef HUFFMAN_BENCH_COUNT_ALLOCS
+    r->allocs_per_call = (double)allocs / (double)calls;
+#else
+    (void)allocs;
+    r->allocs_per_call = -1;
+#endif
+    free(ebuf);
+    free(dbuf);
+}
+
+static void bench_report( const struct bench_corpus *c, enum bench_op op, const struct bench_result *r, int json ) {
+    double avg = (double)c->raw_bytes / c->count;
+    double ratio = (double)c->enc_bytes / (double)c->raw_bytes;
+
+    if (op == BENCH_CODEBOOK_ENCODE || op == BENCH_CODEBOOK_DECODE) ratio = (double)c->cb_bytes / (double)c->raw_bytes;
+
+    if (json) {
+        printf("{\"corpus\":\"%s\",\"op\":\"%s\",\"strings\":%d,\"avg_len\":%.1f,\"ratio\":%.4f,"
+               "\"ns_per_string\":%.2f,\"mb_per_s\":%.2f,\"allocs_per_call\":",
+               c->name, bench_op_names[op], c->count, avg, ratio, r->ns_per_string, r->mb_per_s);
+        if (r->allocs_per_call < 0) printf("null}\n");
+        else printf("%.3f}\n", r->allocs_per_call);
+    } else {
+        printf("%-16s %-26s %8.1f %6.3f %12.1f %10.1f ", c->name, bench_op_names[op], avg, ratio, r->ns_per_string, r->mb_per_s);
+        if (r->allocs_per_call < 0) printf("%12s\n", "n/a");
+        else printf("%12.3f\n", r->allocs_per_call);
+    }
+}
+
+/* Prints the cache hit ratio; every cache call so far should be counted */
+static int bench_report_cache( int quiet ) {
+    struct huffman_cache_stats st;
+
+    if (huffman_cache_get_stats(bench_cache, &st) != HUFFMAN_SUCCESS || !st.hits || !st.misses) {
+        fprintf(stderr, "cache: no hits or misses counted\n");
+        return 1;
+    }
+    if (!quiet) {
+        printf("\ncache: %llu hits, %llu misses (%.2f%% hit ratio), %llu insertions, %llu octets\n",
+               (unsigned long long)st.hits, (unsigned long long)st.misses,
+               100.0 * (double)st.hits / (double)(st.hits + st.misses),
+               (unsigned long long)st.insertions, (unsigned long long)st.bytes);
+    }
+    return 0;
+}
+
+/*
+ * With a HUFFMAN_STATS build, prints the library's own counters and checks
+ * that every coded octet landed in the code length histogram.
+ */
+static int bench_report_stats( int quiet ) {
+    struct huffman_stats st;
+    uint64_t symbols = 0;
+    int i = 0;
+
+    if (huffman_get_stats(&st) != HUFFMAN_SUCCESS) return 0;
+    for (i = 0; i <= HUFFMAN_STATS_MAX_BITS; i++) symbols += st.code_lengths[i];
+    if (symbols != st.encode_bytes_in + st.decode_bytes_out) {
+        fprintf(stderr, "stats: %llu symbols in the histogram, %llu octets coded\n",
+                (unsigned long long)symbols, (unsigned long long)(st.encode_bytes_in + st.decode_bytes_out));
+        return 1;
+    }
+    if (quiet) return 0;
+
+    printf("\nstats: %llu encodes (%.3f ratio), %llu decodes, %llu allocations, %llu reallocations\n",
+           (unsigned long long)st.encode_calls,
+           st.encode_bytes_in ? (double)st.encode_bytes_out / (double)st.encode_bytes_in : 0.0,
+           (unsigned long long)st.decode_calls,
+           (unsigned long long)st.allocations, (unsigned long long)st.reallocations);
+    printf("stats: code lengths");
+    for (i = 5; i <= HUFFMAN_STATS_MAX_BITS; i++) {
+        if (st.code_lengths[i]) printf(" %d:%.2f%%", i, 100.0 * (double)st.code_lengths[i] / (double)symbols);
+    }
+    printf("\nstats: errors");
+    for (i = 1; i < HUFFMAN_STATS_ERRORS; i++) printf(" %d:%llu", -i, (unsigned long long)st.errors[i]);
+    printf("\n");
+    if (st.encode_cycles || st.decode_cycles) {
+        printf("stats: %.2f cycles/octet encoding, %.2f cycles/octet decoding\n",
+               st.encode_bytes_in ? (double)st.encode_cycles / (double)st.encode_bytes_in : 0.0,
+               st.decode_bytes_out ? (double)st.decode_cycles / (double)st.decode_bytes_out : 0.0);
+    }
+    return 0;
+}
+
+static void bench_usage( void ) {
+    fprintf(stderr, "usage: huffman_bench [--json] [--min-time MS] [--verify]\n");
+}
+
+int main( int argc, char **argv ) {
+    static const struct {
+        const char *kind;
+        int len;
+    } plan[] = {
+        { "names", 0 }, { "ua", 0 },
+        { "cookie", 64 }, { "cookie", 256 }, { "cookie", 1024 }, { "cookie", 4096 },
+        { "token", 64 }, { "token", 256 }, { "token", 1024 },
+        { "high-bytes", 16 }, { "high-bytes", 256 }, { "high-bytes", 4096 }
+    };
+    struct bench_corpus *c = 0;
+    struct bench_result r;
+    double min_time = BENCH_DEFAULT_MIN_MS / 1000.0;
+    int i = 0, op = 0, json = 0, verify = 0, failures = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json")) {
+            json = 1;
+        } else if (!strcmp(argv[i], "--verify")) {
+            verify = 1;
+        } else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            min_time = atof(argv[++i]) / 1000.0;
+        } else {
+            bench_usage();
+            return 2;
+        }
+    }
+
+    c = (struct bench_corpus *)malloc(sizeof(*c));
+    bench_cache = huffman_cache_create(BENCH_CACHE_SIZE);
+    if (!c || !bench_cache) {
+        fprintf(stderr, "huffman_bench: out of memory\n");
+        return 2;
+    }
+
+    failures = bench_check_vectors();
+    failures += bench_check_hpack();
+    failures += bench_check_codebook();
+    failures += bench_check_frame();
+    failures += bench_check_checked();
+    if (!json && !verify) {
+        printf("%-16s %-26s %8s %6s %12s %10s %12s\n", "corpus", "op", "avg_len", "ratio", "ns/string", "MB/s", "allocs/call");
+    }
+    for (i = 0; i < (int)(sizeof(plan) / sizeof(plan[0])) && !failures; i++) {
+        bench_make_corpus(c, plan[i].kind, plan[i].len);
+        bench_encode_corpus(c);
+        failures += bench_check_corpus(c);
+        for (op = 0; op < BENCH_OPS && !verify && !failures; op++) {
+            bench_measure(c, (enum bench_op)op, min_time, &r);
+            bench_report(c, (enum bench_op)op, &r, json);
+        }
+        bench_free_corpus(c);
+    }
+    free(c);
+    if (!failures && !verify) bench_measure_frame(min_time, json);
+    if (!failures) failures += bench_report_cache(json || verify);
+    huffman_cache_destroy(bench_cache);
+    huffman_codebook_destroy(bench_hpack_codebook);
+    if (!failures) failures += bench_report_stats(json || verify);
+
+    if (verify) printf("%s\n", failures ? "FAILED" : "OK: RFC 7541 vectors and round trips");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * File:   huffman_cpp_check.cpp
+ *
+ * Checks huffman.hpp: the constexpr encoder against the RFC 7541 vectors
+ * at compile time, and every wrapper against the C library at run time.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "huffman.hpp"
+
+using namespace huffman::literals;
+
+template <std::size_t N>
+constexpr bool same(const std::array<std::uint8_t, N> &a, std::initializer_list<std::uint8_t> b)
+{
+    std::size_t i = 0;
+
+    if (b.size() != N) {
+        return false;
+    }
+    for (std::uint8_t c : b) {
+        if (a[i++] != c) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* RFC 7541, C.4.1 - C.4.3 and C.6.1 */
+static_assert(same("www.example.com"_huffman,
+                   {0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff}));
+static_assert(same("no-cache"_huffman, {0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf}));
+static_assert(same("custom-key"_huffman, {0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f}));
+static_assert(same("custom-value"_huffman, {0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf}));
+static_assert(same("302"_huffman, {0x64, 0x02}));
+static_assert(same(""_huffman, {}));
+static_assert(huffman::encoded_length("Mon, 21 Oct 2013 20:13:21 GMT") == 22);
+static_assert(huffman::max_decoded_length(5) == 8 && huffman::max_decoded_length(4) == 6);
+
+static_assert(!std::is_copy_constructible_v<huffman::encoded_buffer>);
+static_assert(std::is_nothrow_move_constructible_v<huffman::decoded_buffer>);
+
+static int failures;
+
+static void check(bool ok, const char *what, const std::string &input)
+{
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s for \"%s\"\n", what, input.c_str());
+        failures++;
+    }
+}
+
+int main(void)
+{
+    std::vector<std::string> inputs = {
+        "", "a", "GET", ":method", "application/json", "content-type",
+        "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)",
+    };
+    std::string all;
+    unsigned int seed = 12345;
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        all.push_back(static_cast<char>(i));
+    }
+    inputs.push_back(all);
+    for (i = 0; i < 64; i++) {
+        std::string s;
+        int len = static_cast<int>((seed = seed * 1103515245 + 12345) >> 16) % 300;
+
+        while (len-- > 0) {
+            s.push_back(static_cast<char>((seed = seed * 1103515245 + 12345) >> 16));
+        }
+        inputs.push_back(s);
+    }
+
+    for (const std::string &s : inputs) {
+        int len = huffman_encode(reinterpret_cast<const std::uint8_t *>(s.data()),
+                                 static_cast<int>(s.size()), nullptr, 0);
+        std::vector<std::uint8_t> ref(static_cast<std::size_t>(len));
+        std::vector<std::uint8_t> it;
+        std::vector<std::uint8_t> out(ref.size() + 1);
+        std::vector<char> text(s.size());
+        huffman::encoded_buffer enc;
+        huffman::decoded_buffer dec;
+        struct huffman_check hc = {};
+
+        huffman_encode(reinterpret_cast<const std::uint8_t *>(s.data()),
+                       static_cast<int>(s.size()), ref.data(), len);
+
+        check(huffman::encoded_length(s) == ref.size(), "encoded_length", s);
+
+        huffman::encode(s, std::back_inserter(it));
+        check(it == ref, "encode to iterator", s);
+
+        check(huffman::encode(s, std::span<std::uint8_t>(out)) == len &&
+              std::equal(ref.begin(), ref.end(), out.begin()), "encode to span", s);
+        check(huffman::encode(s, std::span<std::uint8_t>(out.data(), ref.size() / 2)) == len ||
+              ref.empty(), "encode to short span", s);
+
+        enc = huffman::encode(s);
+        check(enc.size() == ref.size() && std::equal(ref.begin(), ref.end(), enc.begin()),
+              "encode to buffer", s);
+
+        dec = huffman::decode(enc);
+        check(dec.view() == s, "decode to buffer", s);
+
+        check(huffman::decode(enc, std::span<char>(text)) == static_cast<int>(s.size()) &&
+              std::string_view(text.data(), text.size()) == s, "decode to span", s);
+
+        hc.hash = HUFFMAN_HASH_FNV1A_64;
+        check(huffman::decode_checked(enc, std::span<char>(text), hc) == static_cast<int>(s.size()),
+              "decode_checked", s);
+
+        huffman::decoded_buffer moved(std::move(dec));
+        check(moved.view() == s && dec.empty() && dec.data() == nullptr, "move", s);
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    std::printf("OK: huffman.hpp matches the C library\n");
+    return 0;
+}
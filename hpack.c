@@ -0,0 +1,501 @@
+/*
+ * File:   hpack.c
+ *
+ * HPACK header block coding.  The dynamic table keeps its entries in a
+ * ring indexed by insertion number and their names and values in a ring
+ * of octets, so adding and evicting never allocate.  Lookups go through
+ * hash indexes holding the newest entry per name and per name + value;
+ * since entries leave in insertion order, the newest entry for a key is
+ * the last one to go and an index slot is valid exactly while its entry
+ * is still in the table.
+ */
+
+#include "hpack_build.h"
+
+#define HPACK_INDEX_PROBE 8             /* Slots looked at per dynamic index lookup */
+
+/* RFC 7541 Appendix A and its indexes, from tools/hpack_gen.c */
+#include "hpack_static_table.h"
+
+struct _hpack_entry {
+    uint64_t pos;                       /* Name, then value, in the data ring */
+    uint32_t namelen;
+    uint32_t valuelen;
+};
+
+struct hpack_context {
+    struct _hpack_entry *entries;       /* Ring of live entries by insertion number */
+    uint8_t *data;                      /* Ring of their names and values */
+    struct _hpack_slot *names;          /* Newest entry per name */
+    struct _hpack_slot *fields;         /* Newest entry per name + value */
+    uint64_t inserted;                  /* Entries ever added; the next insertion number */
+    uint64_t evicted;                   /* Entries ever evicted; the oldest live insertion number */
+    uint64_t head;                      /* Octets ever written to 'data' */
+    uint32_t entry_mask;
+    uint32_t data_mask;
+    uint32_t index_mask;
+    int size;                           /* Table size as RFC 7541 section 4.1 counts it */
+    int max_size;                       /* Current maximum table size */
+    int limit;                          /* SETTINGS_HEADER_TABLE_SIZE: the most 'max_size' may be */
+    int update_min;                     /* Encoder: smallest 'max_size' since the last block, or -1 */
+    int error;                          /* Decoder: sticky error code, or ZERO */
+};
+
+static inline int hpack_same( const char *a, int alen, const char *b, int blen ) {
+    return alen == blen && !memcmp(a, b, alen);
+}
+
+/******** Static table index ********/
+
+static int hpack_static_match( int idx, const char *name, int namelen, const char *value, int valuelen ) {
+    const struct _hpack_static_entry *e = &hpack_static[idx-1];
+
+    return hpack_same(e->name, e->namelen, name, namelen) && (!value || hpack_same(e->value, e->valuelen, value, valuelen));
+}
+
+/* Returns the static index of the name (value NULL) or field, or ZERO */
+static int hpack_static_find( const struct _hpack_slot *slots, uint32_t hash, const char *name, int namelen, const char *value, int valuelen ) {
+    const struct _hpack_slot *sl = 0;
+    uint32_t i = 0;
+
+    for (i = hash; ; i++) {
+        sl = &slots[i & (HPACK_STATIC_INDEX_SIZE - 1)];
+        if (!sl->hash) return 0;
+        if (sl->hash == hash && hpack_static_match((int)sl->seq, name, namelen, value, valuelen)) return (int)sl->seq;
+    }
+}
+
+/******** Dynamic table ********/
+
+static inline const char *hpack_entry_name( const struct hpack_context *ctx, const struct _hpack_entry *e ) {
+    return (const char *)ctx->data + (e->pos & ctx->data_mask);
+}
+
+static inline int hpack_live( const struct hpack_context *ctx, uint64_t seq ) {
+    return seq >= ctx->evicted && seq < ctx->inserted;
+}
+
+static int hpack_dynamic_match( const struct hpack_context *ctx, uint64_t seq, const char *name, int namelen, const char *value, int valuelen ) {
+    const struct _hpack_entry *e = &ctx->entries[seq & ctx->entry_mask];
+    const char *p = hpack_entry_name(ctx, e);
+
+    return hpack_same(p, (int)e->namelen, name, namelen)
+        && (!value || hpack_same(p + e->namelen, (int)e->valuelen, value, valuelen));
+}
+
+/* Returns the insertion number of the newest matching entry, or -1 */
+static int64_t hpack_dynamic_find( const struct hpack_context *ctx, const struct _hpack_slot *slots, uint32_t hash,
+                                   const char *name, int namelen, const char *value, int valuelen ) {
+    const struct _hpack_slot *sl = 0;
+    int k = 0;
+
+    for (k = 0; k < HPACK_INDEX_PROBE; k++) {
+        sl = &slots[(hash + k) & ctx->index_mask];
+        if (sl->hash == hash && hpack_live(ctx, sl->seq) && hpack_dynamic_match(ctx, sl->seq, name, namelen, value, valuelen)) {
+            return (int64_t)sl->seq;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Points the index at entry 'seq', in the key's own slot if it has one,
+ * else a free or stale slot, else the slot of the oldest entry nearby
+ * (which then can only be found by a later duplicate).
+ */
+static void hpack_dynamic_index( struct hpack_context *ctx, struct _hpack_slot *slots, uint32_t hash, uint64_t seq,
+                                 const char *name, int namelen, const char *value, int valuelen ) {
+    struct _hpack_slot *sl = 0, *free_slot = 0, *oldest = 0;
+    int k = 0;
+
+    for (k = 0; k < HPACK_INDEX_PROBE; k++) {
+        sl = &slots[(hash + k) & ctx->index_mask];
+        if (!sl->hash || !hpack_live(ctx, sl->seq)) {
+            if (!free_slot) free_slot = sl;
+        } else if (sl->hash == hash && hpack_dynamic_match(ctx, sl->seq, name, namelen, value, valuelen)) {
+            free_slot = sl;
+            break;
+        } else if (!oldest || sl->seq < oldest->seq) {
+            oldest = sl;
+        }
+    }
+    sl = free_slot ? free_slot : oldest;
+    sl->hash = hash;
+    sl->seq = seq;
+}
+
+/* Evicts the oldest entries until 'room' more octets fit (RFC 7541 section 4.4) */
+static void hpack_evict( struct hpack_context *ctx, int room ) {
+    const struct _hpack_entry *e = 0;
+
+    while (ctx->evicted < ctx->inserted && ctx->size + room > ctx->max_size) {
+        e = &ctx->entries[ctx->evicted & ctx->entry_mask];
+        ctx->size -= (int)(e->namelen + e->valuelen) + HPACK_ENTRY_OVERHEAD;
+        ctx->evicted++;
+    }
+}
+
+/*
+ * Adds a field to the dynamic table.  The data ring is at least twice
+ * the largest table and an entry never wraps around it, so the live
+ * entries plus the gap left at a wrap always fit behind the oldest one.
+ */
+static void hpack_add( struct hpack_context *ctx, const char *name, int namelen, const char *value, int valuelen,
+                       uint32_t name_hash, uint32_t field_hash ) {
+    struct _hpack_entry *e = 0;
+    uint64_t pos = 0, seq = 0;
+    uint32_t total = (uint32_t)namelen + (uint32_t)valuelen, off = 0;
+    int esz = namelen + valuelen + HPACK_ENTRY_OVERHEAD;
+
+    hpack_evict(ctx, esz);
+    if (esz > ctx->max_size) return;            /* Too large for any table: it just emptied it */
+
+    pos = ctx->head;
+    off = (uint32_t)(pos & ctx->data_mask);
+    if (off + total > ctx->data_mask + 1) pos += ctx->data_mask + 1 - off;
+    memcpy(ctx->data + (pos & ctx->data_mask), name, namelen);
+    memcpy(ctx->data + (pos & ctx->data_mask) + namelen, value, valuelen);
+    ctx->head = pos + total;
+
+    seq = ctx->inserted++;
+    e = &ctx->entries[seq & ctx->entry_mask];
+    e->pos = pos;
+    e->namelen = (uint32_t)namelen;
+    e->valuelen = (uint32_t)valuelen;
+    ctx->size += esz;
+    hpack_dynamic_index(ctx, ctx->names, name_hash, seq, name, namelen, 0, 0);
+    hpack_dynamic_index(ctx, ctx->fields, field_hash, seq, name, namelen, value, valuelen);
+}
+
+static uint32_t hpack_pow2( uint64_t n ) {
+    uint32_t p = 1;
+
+    while (p < n) p <<= 1;
+    return p;
+}
+
+struct hpack_context *hpack_context_create(int max_table_size) {
+    struct hpack_context *ctx = 0;
+    uint32_t entries = 0, data = 0, index = 0;
+
+    if (max_table_size < 0) return 0;
+
+    entries = hpack_pow2((uint64_t)max_table_size / HPACK_ENTRY_OVERHEAD + 1);
+    data = hpack_pow2((uint64_t)max_table_size * 2);
+    if (data < 64) data = 64;
+    index = hpack_pow2((uint64_t)entries * 4);
+    if (index < 16) index = 16;
+
+    ctx = (struct hpack_context *)calloc(1, sizeof(*ctx));
+    if (!ctx) return 0;
+    ctx->entries = (struct _hpack_entry *)malloc(entries * sizeof(struct _hpack_entry));
+    ctx->data = (uint8_t *)malloc(data);
+    ctx->names = (struct _hpack_slot *)calloc(index, sizeof(struct _hpack_slot));
+    ctx->fields = (struct _hpack_slot *)calloc(index, sizeof(struct _hpack_slot));
+    if (!ctx->entries || !ctx->data || !ctx->names || !ctx->fields) {
+        hpack_context_destroy(ctx);
+        return 0;
+    }
+    ctx->entry_mask = entries - 1;
+    ctx->data_mask = data - 1;
+    ctx->index_mask = index - 1;
+    ctx->max_size = ctx->limit = max_table_size;
+    ctx->update_min = -1;
+    return ctx;
+}
+
+void hpack_context_destroy(struct hpack_context *ctx) {
+    if (!ctx) return;
+    free(ctx->entries);
+    free(ctx->data);
+    free(ctx->names);
+    free(ctx->fields);
+    free(ctx);
+}
+
+int hpack_set_max_table_size(struct hpack_context *ctx, int size) {
+    if (!ctx || size < 0 || size > ctx->limit) return HUFFMAN_BAD_PARAMETER;
+    ctx->max_size = size;
+    hpack_evict(ctx, 0);
+    if (ctx->update_min < 0 || size < ctx->update_min) ctx->update_min = size;
+    return HUFFMAN_SUCCESS;
+}
+
+/******** Primitive representations ********/
+
+static int hpack_integer_size( uint32_t value, int prefix_bits ) {
+    uint32_t max = (1u << prefix_bits) - 1;
+    int n = 1;
+
+    if (value < max) return 1;
+    for (value -= max; value >= 128; value >>= 7) n++;
+    return n + 1;
+}
+
+int hpack_encode_integer(uint32_t value, int prefix_bits, uint8_t first, uint8_t *output, int outcap) {
+    uint32_t max = 0;
+    int n = 0;
+
+    if (!output || prefix_bits < 1 || prefix_bits > 8) return HUFFMAN_BAD_PARAMETER;
+    if (outcap < hpack_integer_size(value, prefix_bits)) return HPACK_BUFFER_TOO_SMALL;
+    max = (1u << prefix_bits) - 1;
+    first &= (uint8_t)~max;
+    if (value < max) {
+        output[0] = first | (uint8_t)value;
+        return 1;
+    }
+    output[n++] = first | (uint8_t)max;
+    for (value -= max; value >= 128; value >>= 7) output[n++] = (uint8_t)(value | 0x80);
+    output[n++] = (uint8_t)value;
+    return n;
+}
+
+int hpack_decode_integer(const uint8_t *input, int inlen, int prefix_bits, uint32_t *value) {
+    uint32_t max = 0, v = 0, add = 0;
+    int n = 1, shift = 0;
+    uint8_t b = 0;
+
+    if (!input || !value || prefix_bits < 1 || prefix_bits > 8) return HUFFMAN_BAD_PARAMETER;
+    if (inlen < 1) return HPACK_COMPRESSION_ERROR;
+    max = (1u << prefix_bits) - 1;
+    v = input[0] & max;
+    if (v == max) {
+        do {
+            if (n >= inlen || shift > 28) return HPACK_COMPRESSION_ERROR;
+            b = input[n++];
+            add = (uint32_t)(b & 0x7f) << shift;
+            if ((add >> shift) != (uint32_t)(b & 0x7f) || add > (uint32_t)INT32_MAX - v) return HPACK_COMPRESSION_ERROR;
+            v += add;
+            shift += 7;
+        } while (b & 0x80);
+    }
+    *value = v;
+    return n;
+}
+
+/*
+ * The literal's length prefix is sized for the raw string, the longest
+ * the literal can be, so the string is coded in place right behind it;
+ * when the Huffman form needs a shorter prefix it moves up.
+ */
+int hpack_encode_string(const uint8_t *input, int inlen, uint8_t *output, int outcap) {
+    int p = 0, q = 0, len = 0, huffman = 0;
+
+    if (inlen < 0 || (!input && inlen) || !output || outcap < 0) return HUFFMAN_BAD_PARAMETER;
+    p = hpack_integer_size((uint32_t)inlen, 7);
+    if (outcap < p) return HPACK_BUFFER_TOO_SMALL;
+    len = huffman_encode_if_shorter(input, inlen, output + p, outcap - p, &huffman);
+    if (len < 0) return len;
+    if (len > outcap - p) return HPACK_BUFFER_TOO_SMALL;
+    q = hpack_integer_size((uint32_t)len, 7);
+    if (q < p) memmove(output + q, output + p, len);
+    hpack_encode_integer((uint32_t)len, 7, huffman ? 0x80 : 0, output, q);
+    return q + len;
+}
+
+/* Reads a string literal into 'output'; returns the octets of input used */
+static int hpack_decode_string( const uint8_t *input, int inlen, char *output, int outcap, int *outlen ) {
+    struct huffman_decoder d;
+    uint32_t len = 0;
+    int n = 0, w = 0, rc = 0;
+
+    n = hpack_decode_integer(input, inlen, 7, &len);
+    if (n < 0) return n;
+    if (len > (uint32_t)(inlen - n)) return HPACK_COMPRESSION_ERROR;
+    if (!(input[0] & 0x80)) {
+        if ((int)len > outcap) return HPACK_BUFFER_TOO_SMALL;
+        memcpy(output, input + n, len);
+        *outlen = (int)len;
+        return n + (int)len;
+    }
+    if (outcap < HUFFMAN_DECODER_BOUND((int)len)) return HPACK_BUFFER_TOO_SMALL;
+    huffman_decoder_init(&d);
+    w = huffman_decoder_feed(&d, input + n, (int)len, output, outcap);
+    if (w < 0) return w;
+    rc = huffman_decoder_finish(&d);
+    if (rc != HUFFMAN_SUCCESS) return rc;
+    *outlen = w;
+    return n + (int)len;
+}
+
+/******** Header blocks ********/
+
+int hpack_encode(struct hpack_context *ctx, const struct hpack_header *headers, int count, uint8_t *output, int outcap) {
+    const struct hpack_header *h = 0;
+    uint64_t bound = HPACK_BLOCK_OVERHEAD;
+    uint32_t nh = 0, fh = 0;
+    int64_t seq = -1;
+    int i = 0, n = 0, idx = 0, prefix = 0, indexing = 0;
+    uint8_t pattern = 0;
+
+    if (!ctx || count < 0 || (!headers && count) || !output || outcap < 0) return HUFFMAN_BAD_PARAMETER;
+    for (i = 0; i < count; i++) {
+        h = &headers[i];
+        if (h->namelen < 0 || h->valuelen < 0 || (!h->name && h->namelen) || (!h->value && h->valuelen)) return HUFFMAN_BAD_PARAMETER;
+        bound += HPACK_FIELD_BOUND((uint64_t)h->namelen, (uint64_t)h->valuelen);
+    }
+    if (bound > (uint64_t)outcap) return HPACK_BUFFER_TOO_SMALL;
+
+    /* Signal the smallest size since the last block, then the current one */
+    if (ctx->update_min >= 0) {
+        if (ctx->update_min < ctx->max_size) n += hpack_encode_integer((uint32_t)ctx->update_min, 5, 0x20, output + n, outcap - n);
+        n += hpack_encode_integer((uint32_t)ctx->max_size, 5, 0x20, output + n, outcap - n);
+        ctx->update_min = -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        h = &headers[i];
+        nh = hpack_hash((const uint8_t *)h->name, h->namelen, 0);
+        fh = hpack_hash((const uint8_t *)h->value, h->valuelen, nh);
+
+        if (!(h->flags & HPACK_NEVER_INDEX)) {
+            idx = hpack_static_find(hpack_static_fields, fh, h->name, h->namelen, h->value, h->valuelen);
+            if (!idx && (seq = hpack_dynamic_find(ctx, ctx->fields, fh, h->name, h->namelen, h->value, h->valuelen)) >= 0) {
+                idx = HPACK_STATIC_ENTRIES + (int)(ctx->inserted - (uint64_t)seq);
+            }
+            if (idx) {
+                n += hpack_encode_integer((uint32_t)idx, 7, 0x80, output + n, outcap - n);
+                continue;
+            }
+        }
+
+        idx = hpack_static_find(hpack_static_names, nh, h->name, h->namelen, 0, 0);
+        if (!idx && (seq = hpack_dynamic_find(ctx, ctx->names, nh, h->name, h->namelen, 0, 0)) >= 0) {
+            idx = HPACK_STATIC_ENTRIES + (int)(ctx->inserted - (uint64_t)seq);
+        }
+        indexing = 0;
+        if (h->flags & HPACK_NEVER_INDEX) {
+            pattern = 0x10;
+            prefix = 4;
+        } else if ((h->flags & HPACK_NO_INDEX) || (uint64_t)h->namelen + h->valuelen + HPACK_ENTRY_OVERHEAD > (uint64_t)ctx->max_size) {
+            pattern = 0x00;
+            prefix = 4;
+        } else {
+            pattern = 0x40;
+            prefix = 6;
+            indexing = 1;
+        }
+        n += hpack_encode_integer((uint32_t)idx, prefix, pattern, output + n, outcap - n);
+        if (!idx) n += hpack_encode_string((const uint8_t *)h->name, h->namelen, output + n, outcap - n);
+        n += hpack_encode_string((const uint8_t *)h->value, h->valuelen, output + n, outcap - n);
+        if (indexing) hpack_add(ctx, h->name, h->namelen, h->value, h->valuelen, nh, fh);
+    }
+    return n;
+}
+
+/*
+ * Resolves a table index.  Dynamic entries are copied to 'buf', since
+ * a later insertion in the same block may evict them; static ones are
+ * pointed at.  Returns the octets of 'buf' used.
+ */
+static int hpack_decode_index( const struct hpack_context *ctx, uint32_t idx, int with_value, struct hpack_header *out, char *buf, int bufcap ) {
+    const struct _hpack_entry *e = 0;
+    const char *p = 0;
+    int len = 0;
+
+    if (!idx) return HPACK_COMPRESSION_ERROR;
+    if (idx <= HPACK_STATIC_ENTRIES) {
+        out->name = hpack_static[idx-1].name;
+        out->namelen = hpack_static[idx-1].namelen;
+        out->value = hpack_static[idx-1].value;
+        out->valuelen = hpack_static[idx-1].valuelen;
+        return 0;
+    }
+    if (idx - HPACK_STATIC_ENTRIES > ctx->inserted - ctx->evicted) return HPACK_COMPRESSION_ERROR;
+    e = &ctx->entries[(ctx->inserted - (idx - HPACK_STATIC_ENTRIES)) & ctx->entry_mask];
+    p = hpack_entry_name(ctx, e);
+    len = (int)e->namelen + (with_value ? (int)e->valuelen : 0);
+    if (len > bufcap) return HPACK_BUFFER_TOO_SMALL;
+    memcpy(buf, p, len);
+    out->name = buf;
+    out->namelen = (int)e->namelen;
+    out->value = buf + e->namelen;
+    out->valuelen = with_value ? (int)e->valuelen : 0;
+    return len;
+}
+
+static int hpack_decode_block( struct hpack_context *ctx, const uint8_t *input, int inlen, struct hpack_header *headers, int maxheaders, char *buf, int bufcap ) {
+    struct hpack_header *h = 0;
+    uint32_t v = 0, nh = 0;
+    int pos = 0, used = 0, count = 0, n = 0, len = 0, prefix = 0, indexing = 0;
+    uint8_t b = 0;
+
+    while (pos < inlen) {
+        b = input[pos];
+
+        if ((b & 0xe0) == 0x20) {               /* Dynamic table size update, only ahead of the fields */
+            if (count) return HPACK_COMPRESSION_ERROR;
+            n = hpack_decode_integer(input + pos, inlen - pos, 5, &v);
+            if (n < 0) return n;
+            if (v > (uint32_t)ctx->limit) return HPACK_COMPRESSION_ERROR;
+            pos += n;
+            ctx->max_size = (int)v;
+            hpack_evict(ctx, 0);
+            continue;
+        }
+
+        if (count >= maxheaders) return HPACK_BUFFER_TOO_SMALL;
+        h = &headers[count];
+        h->flags = 0;
+
+        if (b & 0x80) {                         /* Indexed header field */
+            n = hpack_decode_integer(input + pos, inlen - pos, 7, &v);
+            if (n < 0) return n;
+            pos += n;
+            n = hpack_decode_index(ctx, v, 1, h, buf + used, bufcap - used);
+            if (n < 0) return n;
+            used += n;
+            count++;
+            continue;
+        }
+
+        if (b & 0x40) {                         /* Literal with incremental indexing */
+            prefix = 6;
+            indexing = 1;
+        } else {                                /* Literal without indexing / never indexed */
+            prefix = 4;
+            indexing = 0;
+            h->flags = (b & 0x10) ? HPACK_NEVER_INDEX : HPACK_NO_INDEX;
+        }
+        n = hpack_decode_integer(input + pos, inlen - pos, prefix, &v);
+        if (n < 0) return n;
+        pos += n;
+        if (v) {
+            n = hpack_decode_index(ctx, v, 0, h, buf + used, bufcap - used);
+            if (n < 0) return n;
+            used += n;
+        } else {
+            n = hpack_decode_string(input + pos, inlen - pos, buf + used, bufcap - used, &len);
+            if (n < 0) return n;
+            pos += n;
+            h->name = buf + used;
+            h->namelen = len;
+            used += len;
+        }
+        n = hpack_decode_string(input + pos, inlen - pos, buf + used, bufcap - used, &len);
+        if (n < 0) return n;
+        pos += n;
+        h->value = buf + used;
+        h->valuelen = len;
+        used += len;
+        count++;
+
+        if (indexing) {
+            nh = hpack_hash((const uint8_t *)h->name, h->namelen, 0);
+            hpack_add(ctx, h->name, h->namelen, h->value, h->valuelen, nh, hpack_hash((const uint8_t *)h->value, h->valuelen, nh));
+        }
+    }
+    return count;
+}
+
+int hpack_decode(struct hpack_context *ctx, const uint8_t *input, int inlen, struct hpack_header *headers, int maxheaders, char *buf, int bufcap) {
+    int rc = 0;
+
+    if (!ctx || inlen < 0 || (!input && inlen) || maxheaders < 0 || (!headers && maxheaders) || bufcap < 0 || (!buf && bufcap)) {
+        return HUFFMAN_BAD_PARAMETER;
+    }
+    if (ctx->error) return ctx->error;
+    rc = hpack_decode_block(ctx, input, inlen, headers, maxheaders, buf, bufcap);
+    if (rc < 0) ctx->error = rc;
+    return rc;
+}
@@ -0,0 +1,273 @@
+/*
+ * File:   hpack.h
+ *
+ * HPACK (RFC 7541) header block coding on top of the Huffman codec:
+ * integer and string literal representations, the static table and a
+ * per-connection dynamic table.  Both tables are reached through hash
+ * indexes, so encoding a field never scans a table.
+ */
+
+#ifndef HPACK_H
+#define HPACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "huffman.h"
+
+#define HPACK_BUFFER_TOO_SMALL -9       /* Not enough room for the output */
+#define HPACK_COMPRESSION_ERROR -8      /* The header block is malformed (RFC 7541 section 6) */
+
+#define HPACK_STATIC_ENTRIES 61
+#define HPACK_DEFAULT_TABLE_SIZE 4096   /* SETTINGS_HEADER_TABLE_SIZE until the peer says otherwise */
+#define HPACK_ENTRY_OVERHEAD 32         /* Added to name and value length for table size accounting */
+
+#define HPACK_NO_INDEX 0x01             /* Send as a literal without indexing */
+#define HPACK_NEVER_INDEX 0x02          /* Send as a never-indexed literal (e.g. cookies, tokens) */
+
+/*
+ * Most octets hpack_encode() needs for one field, and for the table size
+ * updates it may put in front of a block.
+ */
+#define HPACK_FIELD_BOUND(namelen, valuelen) ((namelen) + (valuelen) + 13)
+#define HPACK_BLOCK_OVERHEAD 12
+
+/*
+ * One header field.  The strings are not NUL-terminated.
+ */
+struct hpack_header {
+    const char *name;
+    int namelen;
+    const char *value;
+    int valuelen;
+    int flags;                          /* HPACK_NO_INDEX / HPACK_NEVER_INDEX */
+};
+
+/*
+ * Compression state for one direction of one connection: a connection
+ * needs one context to encode what it sends and another to decode what
+ * it receives.  Treat it as opaque.
+ */
+struct hpack_context;
+
+
+/*
+ * hpack_context_create() - Allocates a context and its dynamic table.
+ *
+ * PARAMETERS:
+ *
+ *      max_table_size  - The SETTINGS_HEADER_TABLE_SIZE in effect: the
+ *                        one the peer sent, for an encoder, or the one
+ *                        sent to the peer, for a decoder.  Use
+ *                        HPACK_DEFAULT_TABLE_SIZE when none was sent.
+ *                        All table memory is allocated up front for this
+ *                        size.
+ *
+ * RETURNS:
+ *
+ *      The new context, or NULL when 'max_table_size' is negative or the
+ *      memory could not be allocated.
+ *
+ */
+struct hpack_context *hpack_context_create(int max_table_size);
+
+
+/*
+ * hpack_context_destroy() - Frees a context.
+ */
+void hpack_context_destroy(struct hpack_context *ctx);
+
+
+/*
+ * hpack_set_max_table_size() - Makes an encoder shrink (or grow back) its
+ *                              dynamic table.  The change is signalled to
+ *                              the peer at the start of the next block.
+ *
+ * PARAMETERS:
+ *
+ *      ctx             - An encoding context.
+ *
+ *      size            - The new size, at most the 'max_table_size' the
+ *                        context was created with.
+ *
+ * RETURNS:
+ *
+ *      HUFFMAN_SUCCESS         - The change is queued.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - No context or a size out of range.
+ *
+ */
+int hpack_set_max_table_size(struct hpack_context *ctx, int size);
+
+
+/*
+ * hpack_encode() - Encodes a header list into one header block.
+ *
+ * PARAMETERS:
+ *
+ *      ctx             - The connection's encoding context.
+ *
+ *      headers         - The fields to encode, in order.  Fields that
+ *                        are not in either table are added to the dynamic
+ *                        table unless their flags say otherwise.
+ *
+ *      count           - The number of fields.
+ *
+ *      output          - The buffer to receive the header block.
+ *
+ *      outcap          - The size in octets of 'output'.  It must be at
+ *                        least HPACK_BLOCK_OVERHEAD plus HPACK_FIELD_BOUND()
+ *                        of every field; the block is usually far shorter.
+ *
+ * RETURNS:
+ *
+ *      The size in octets of the header block.
+ *
+ *      HPACK_BUFFER_TOO_SMALL  - 'outcap' is below the bound.  Nothing was
+ *                                written and the context is unchanged.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A NULL pointer or a negative length.
+ *
+ */
+int hpack_encode(struct hpack_context *ctx, const struct hpack_header *headers, int count, uint8_t *output, int outcap);
+
+
+/*
+ * hpack_decode() - Decodes one complete header block.
+ *
+ * PARAMETERS:
+ *
+ *      ctx             - The connection's decoding context.
+ *
+ *      input           - The header block (the concatenated HEADERS and
+ *                        CONTINUATION fragments).
+ *
+ *      inlen           - The size in octets of the header block.
+ *
+ *      headers         - Receives up to 'maxheaders' fields.  Names and
+ *                        values point into 'buf' or at the static table.
+ *                        The flags say how each field arrived:
+ *                        HPACK_NEVER_INDEX for never-indexed literals and
+ *                        HPACK_NO_INDEX for literals without indexing, so
+ *                        a proxy can forward them the same way.
+ *
+ *      maxheaders      - The size of 'headers'.
+ *
+ *      buf             - Storage for the decoded names and values.  A
+ *                        Huffman-coded string of 'len' encoded octets
+ *                        needs HUFFMAN_DECODER_BOUND(len), that is
+ *                        (8 * len + 29) / 5 octets, left in 'buf' while
+ *                        it is decoded, though it only keeps its decoded
+ *                        length.
+ *
+ *      bufcap          - The size in octets of 'buf'.
+ *
+ * RETURNS:
+ *
+ *      The number of fields decoded.
+ *
+ *      HPACK_COMPRESSION_ERROR - The block is malformed.
+ *
+ *      HPACK_BUFFER_TOO_SMALL  - 'headers' or 'buf' ran out.
+ *
+ *      HUFFMAN_EOS_DECODED, HUFFMAN_PADDING_TOO_LONG,
+ *      HUFFMAN_PADDING_INVALID - A string literal was badly coded.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A NULL pointer or a negative length.
+ *
+ *      The dynamic table is only partly updated after an error, so any
+ *      error leaves the context unusable (it keeps returning the error);
+ *      HTTP/2 treats them all as connection errors.
+ *
+ */
+int hpack_decode(struct hpack_context *ctx, const uint8_t *input, int inlen, struct hpack_header *headers, int maxheaders, char *buf, int bufcap);
+
+
+/*
+ * hpack_encode_integer() - Writes an integer with an N-bit prefix
+ *                          (RFC 7541 section 5.1).
+ *
+ * PARAMETERS:
+ *
+ *      value           - The integer.
+ *
+ *      prefix_bits     - N, from 1 to 8.
+ *
+ *      first           - The bits above the prefix in the first octet
+ *                        (the representation's pattern).
+ *
+ *      output          - The buffer to receive the integer.
+ *
+ *      outcap          - The size in octets of 'output'.
+ *
+ * RETURNS:
+ *
+ *      The number of octets written (at most 6).
+ *
+ *      HPACK_BUFFER_TOO_SMALL  - 'outcap' is too small.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A bad prefix or a NULL output.
+ *
+ */
+int hpack_encode_integer(uint32_t value, int prefix_bits, uint8_t first, uint8_t *output, int outcap);
+
+
+/*
+ * hpack_decode_integer() - Reads an integer with an N-bit prefix.
+ *
+ * PARAMETERS:
+ *
+ *      input           - The first octet of the integer.
+ *
+ *      inlen           - The number of octets available.
+ *
+ *      prefix_bits     - N, from 1 to 8.
+ *
+ *      value           - Receives the integer.
+ *
+ * RETURNS:
+ *
+ *      The number of octets read.
+ *
+ *      HPACK_COMPRESSION_ERROR - The integer is cut short or does not fit
+ *                                in 31 bits.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A bad prefix or a NULL pointer.
+ *
+ */
+int hpack_decode_integer(const uint8_t *input, int inlen, int prefix_bits, uint32_t *value);
+
+
+/*
+ * hpack_encode_string() - Writes a string literal (RFC 7541 section 5.2),
+ *                         Huffman-coded when that makes it shorter.
+ *
+ * PARAMETERS:
+ *
+ *      input           - The string.
+ *
+ *      inlen           - The size in octets of the string.
+ *
+ *      output          - The buffer to receive the literal.
+ *
+ *      outcap          - The size in octets of 'output'.
+ *
+ * RETURNS:
+ *
+ *      The number of octets written (at most 'inlen' + 6).
+ *
+ *      HPACK_BUFFER_TOO_SMALL  - 'outcap' is too small.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A NULL pointer or a negative length.
+ *
+ */
+int hpack_encode_string(const uint8_t *input, int inlen, uint8_t *output, int outcap);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HPACK_H */
@@ -0,0 +1,65 @@
+/*
+ * File:   hpack_build.h
+ *
+ * Static table layout and field hash shared by hpack.c and the table
+ * generator in tools/hpack_gen.c, so the static table's hash indexes can
+ * be laid out at build time and still match the hashes hpack.c computes
+ * for the fields it is given.
+ */
+
+#ifndef HPACK_BUILD_H
+#define HPACK_BUILD_H
+
+#include "hpack.h"
+
+#define HPACK_STATIC_INDEX_SIZE 256     /* Power of two, well above HPACK_STATIC_ENTRIES */
+
+/*
+ * Index slot: the hash of a name (or name + value) and the entry it was
+ * last seen in, an insertion number for the dynamic table or a static
+ * table index.  'hash' is never ZERO in a used slot.
+ */
+struct _hpack_slot {
+    uint64_t seq;
+    uint32_t hash;
+    uint32_t spare;
+};
+
+struct _hpack_static_entry {
+    const char *name;
+    const char *value;
+    int namelen;
+    int valuelen;
+};
+
+/* Up to 8 octets, least significant first, whatever the byte order */
+static inline uint64_t hpack_load64( const uint8_t *p, int len ) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t w = 0;
+
+    memcpy(&w, p, len);
+#else
+    uint64_t w = 0;
+    int i = 0;
+
+    for (i = len - 1; i >= 0; i--) w = (w << 8) | p[i];
+#endif
+    return w;
+}
+
+static inline uint32_t hpack_hash( const uint8_t *p, int len, uint32_t seed ) {
+    const uint64_t k = 0x9e3779b97f4a7c15ULL;
+    uint64_t h = (((uint64_t)seed << 32) | (uint32_t)len) * k;
+    int i = 0;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        h = (h ^ hpack_load64(p + i, 8)) * k;
+        h ^= h >> 31;
+    }
+    h = (h ^ ((len > i) ? hpack_load64(p + i, len - i) : 0)) * k;
+    h ^= h >> 32;
+    h *= k;
+    return (uint32_t)(h >> 32) | 1;
+}
+
+#endif /* HPACK_BUILD_H */
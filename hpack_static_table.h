@@ -0,0 +1,205 @@
+/*
+ * Generated by tools/hpack_gen.c from hpack_static.inc.  Do not edit.
+ *
+ * The static table with {name, value, name length, value length}, and
+ * its indexes by name and by name + value: open addressing over 256
+ * slots of {static index, hash, 0}, the lowest index winning ties.
+ */
+
+static const struct _hpack_static_entry hpack_static[HPACK_STATIC_ENTRIES] = {
+    { ":authority", "", 10, 0 },
+    { ":method", "GET", 7, 3 },
+    { ":method", "POST", 7, 4 },
+    { ":path", "/", 5, 1 },
+    { ":path", "/index.html", 5, 11 },
+    { ":scheme", "http", 7, 4 },
+    { ":scheme", "https", 7, 5 },
+    { ":status", "200", 7, 3 },
+    { ":status", "204", 7, 3 },
+    { ":status", "206", 7, 3 },
+    { ":status", "304", 7, 3 },
+    { ":status", "400", 7, 3 },
+    { ":status", "404", 7, 3 },
+    { ":status", "500", 7, 3 },
+    { "accept-charset", "", 14, 0 },
+    { "accept-encoding", "gzip, deflate", 15, 13 },
+    { "accept-language", "", 15, 0 },
+    { "accept-ranges", "", 13, 0 },
+    { "accept", "", 6, 0 },
+    { "access-control-allow-origin", "", 27, 0 },
+    { "age", "", 3, 0 },
+    { "allow", "", 5, 0 },
+    { "authorization", "", 13, 0 },
+    { "cache-control", "", 13, 0 },
+    { "content-disposition", "", 19, 0 },
+    { "content-encoding", "", 16, 0 },
+    { "content-language", "", 16, 0 },
+    { "content-length", "", 14, 0 },
+    { "content-location", "", 16, 0 },
+    { "content-range", "", 13, 0 },
+    { "content-type", "", 12, 0 },
+    { "cookie", "", 6, 0 },
+    { "date", "", 4, 0 },
+    { "etag", "", 4, 0 },
+    { "expect", "", 6, 0 },
+    { "expires", "", 7, 0 },
+    { "from", "", 4, 0 },
+    { "host", "", 4, 0 },
+    { "if-match", "", 8, 0 },
+    { "if-modified-since", "", 17, 0 },
+    { "if-none-match", "", 13, 0 },
+    { "if-range", "", 8, 0 },
+    { "if-unmodified-since", "", 19, 0 },
+    { "last-modified", "", 13, 0 },
+    { "link", "", 4, 0 },
+    { "location", "", 8, 0 },
+    { "max-forwards", "", 12, 0 },
+    { "proxy-authenticate", "", 18, 0 },
+    { "proxy-authorization", "", 19, 0 },
+    { "range", "", 5, 0 },
+    { "referer", "", 7, 0 },
+    { "refresh", "", 7, 0 },
+    { "retry-after", "", 11, 0 },
+    { "server", "", 6, 0 },
+    { "set-cookie", "", 10, 0 },
+    { "strict-transport-security", "", 25, 0 },
+    { "transfer-encoding", "", 17, 0 },
+    { "user-agent", "", 10, 0 },
+    { "vary", "", 4, 0 },
+    { "via", "", 3, 0 },
+    { "www-authenticate", "", 16, 0 }
+};
+
+static const struct _hpack_slot hpack_static_names[HPACK_STATIC_INDEX_SIZE] = {
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {25,0x61321103,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {50,0x5a026107,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {32,0xbefd3a19,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {54,0xfd23b01f,0},
+    {42,0x73d7a71f,0}, {40,0x314c1d1f,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {27,0x2e41f12b,0},
+    {0,0x00000000,0}, {22,0x7830cc2d,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {26,0x6d235e31,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {20,0xacedc23b,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {23,0xbe8d8843,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {19,0xc0c71d49,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {48,0xa802404d,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {35,0x83628c53,0},
+    {0,0x00000000,0}, {29,0xfce71f55,0}, {0,0x00000000,0}, {2,0x59279b57,0},
+    {0,0x00000000,0}, {33,0xfd821159,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {30,0xbcb6c461,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {8,0x58c6a86f,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {51,0xcc0a0b75,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {38,0x907ec77d,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {47,0xeaca1481,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {43,0xdc614f85,0}, {15,0x9e5bc385,0}, {56,0xb31a9487,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {55,0x41ee5e91,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {53,0xae2a9199,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {49,0x5716fd9f,0},
+    {0,0x00000000,0}, {60,0x4b956ea1,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {37,0x556bada9,0}, {18,0x56b236a9,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {17,0x3acc1cb9,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {21,0x899376bd,0}, {0,0x00000000,0}, {4,0x466dfcbf,0},
+    {0,0x00000000,0}, {16,0xea83c9c1,0}, {0,0x00000000,0}, {52,0xc10facc3,0},
+    {0,0x00000000,0}, {36,0x1e2964c5,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {41,0xf0a7e0cd,0}, {0,0x00000000,0}, {39,0x5cd7cecf,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {46,0xf916c8db,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {24,0x615d68df,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {6,0xf5e1c0e5,0}, {0,0x00000000,0}, {1,0xb4ea3ee7,0},
+    {0,0x00000000,0}, {59,0x4ae92ee9,0}, {31,0xf3bbb7e9,0}, {28,0xa2ac7be9,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {61,0xef6b8def,0},
+    {44,0x1ec68def,0}, {0,0x00000000,0}, {0,0x00000000,0}, {34,0x07a984f3,0},
+    {0,0x00000000,0}, {58,0x37351cf5,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {45,0x5e0f52f9,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {57,0x2d60bbff,0}
+};
+
+static const struct _hpack_slot hpack_static_fields[HPACK_STATIC_INDEX_SIZE] = {
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {3,0x5af42705,0}, {0,0x00000000,0}, {59,0x02b4c507,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {2,0xcfeac80b,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {20,0x8323580f,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {35,0x1d735515,0}, {22,0x9393d715,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {55,0xc0a03019,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {29,0x388c7621,0}, {0,0x00000000,0}, {15,0xeed4be23,0},
+    {11,0xd58a6823,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {21,0x5cce3f2b,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {9,0x7182b62f,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {14,0x46f45c33,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {1,0x426d0f3f,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {60,0x5b303f53,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {41,0x16e6ff57,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {17,0xb6a3fd5f,0},
+    {0,0x00000000,0}, {53,0x5ca67161,0}, {0,0x00000000,0}, {42,0xe395fe63,0},
+    {0,0x00000000,0}, {6,0xaa76e165,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {5,0x73a2716f,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {40,0x0d00fc7d,0}, {33,0x76e83a7d,0}, {25,0x7be68c7d,0},
+    {18,0x631e567d,0}, {34,0x5bf5ca81,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {57,0x037c3587,0},
+    {4,0xf8134887,0}, {27,0x748b1b89,0}, {12,0xf02deb89,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {37,0xa86afe93,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {51,0x2d7ce099,0}, {19,0xd6d75199,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {44,0xc38804a7,0},
+    {0,0x00000000,0}, {7,0x34ab7ba9,0}, {0,0x00000000,0}, {43,0x58d8c5ab,0},
+    {0,0x00000000,0}, {49,0x85869dad,0}, {0,0x00000000,0}, {8,0xc86a7caf,0},
+    {0,0x00000000,0}, {26,0x2bf421b1,0}, {0,0x00000000,0}, {38,0x7389f0b3,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {31,0x5d135eb7,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {50,0xcb3f67bb,0},
+    {45,0x210551bb,0}, {16,0x27fc88bb,0}, {13,0x2ba5b8bd,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {30,0x5b6d60c7,0},
+    {0,0x00000000,0}, {36,0xba208dc9,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {32,0x2edb53d1,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {58,0xc8014ad5,0}, {24,0xe46b1ad5,0}, {54,0x88252bd7,0},
+    {0,0x00000000,0}, {61,0x5fa2d2d9,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {23,0x279672dd,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {46,0x07c1cde1,0}, {0,0x00000000,0}, {56,0x0c1d1be3,0},
+    {28,0xedfcafe3,0}, {39,0x26d928e5,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {48,0x312f9feb,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {52,0x48115fef,0},
+    {0,0x00000000,0}, {47,0xd076fef1,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0}, {0,0x00000000,0},
+    {0,0x00000000,0}, {10,0xdd2e8efd,0}, {0,0x00000000,0}, {0,0x00000000,0}
+};
@@ -1,4 +1,21 @@
 #include "huffman.h"
+#include "huffman_build.h"
+#include "huffman_stats.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(HUFFMAN_NO_SIMD)
+#define HUFFMAN_HAVE_AVX2 1
+#include <immintrin.h>
+#else
+#define HUFFMAN_HAVE_AVX2 0
+#endif
+
+#define HUFFMAN_SIMD_MIN_LENGTH 32      /* Shorter strings stay on the scalar path */
+
+const struct _hpack_table hpack_table[HPACK_SIZE] = {
+#include "hpack_table.inc"
+};
+
+static const int huffman_bits = (sizeof(int *) * 8);
 
 void huffman_zero_mem( void *ptr, size_t length ) {
     int i = 0;
@@ -25,171 +42,942 @@ void huffman_zero_mem( void *ptr, size_t length ) {
     return;
 }
 
+/*
+ * Generated at build time by tools/huffman_gen.c: one read-only copy, no
+ * initialization, safe to share between any number of threads.
+ */
+#include "huffman_decode_table.h"
+
+static inline uint64_t huffman_load_be64( const uint8_t *p ) {
+    uint64_t v = 0;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#elif !defined(__BYTE_ORDER__)
+    v = ((uint64_t)ntohl((uint32_t)v) << 32) | ntohl((uint32_t)(v >> 32));
+#endif
+    return v;
+}
+
 int prep_hpack_compression( void ) {
-    phpack_table_deocde_sorted = (struct _hpack_table *)malloc(HPACK_BYTES);
-    if (!phpack_table_deocde_sorted) {
-        return HUFFMAN_NO_MEMORY;
+    return HUFFMAN_SUCCESS;
+}
+
+static inline void huffman_store_be32( uint8_t *p, uint32_t v ) {
+    v = htonl(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+#define HUFFMAN_LENGTH_BLOCK 32        /* Octets summed between checks against the limit */
+
+static int huffman_encoded_bits_simd( const struct _hpack_table *codes, const uint8_t *input, int inlen, uint64_t limit, uint64_t *bits );
+
+/*
+ * Total number of bits the Huffman code for 'input' occupies (no padding).
+ * The running sum is checked against 'limit' after every block, and once
+ * it is past it the partial sum (> 'limit') comes back right away: a
+ * caller that only wants strings up to some size does not pay for
+ * summing the rest of one that has already failed.
+ */
+static uint64_t huffman_encoded_bits_limited( const struct _hpack_table *codes, const uint8_t *input, int inlen, uint64_t limit ) {
+    uint64_t bits = 0;
+    uint32_t b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+    int i = huffman_encoded_bits_simd(codes, input, inlen, limit, &bits), k = 0;
+    
+    for (; i + HUFFMAN_LENGTH_BLOCK <= inlen && bits <= limit; i += HUFFMAN_LENGTH_BLOCK) {
+        b0 = b1 = b2 = b3 = 0;
+        for (k = 0; k < HUFFMAN_LENGTH_BLOCK; k += 4) {
+            b0 += codes[input[i+k]].bits;
+            b1 += codes[input[i+k+1]].bits;
+            b2 += codes[input[i+k+2]].bits;
+            b3 += codes[input[i+k+3]].bits;
+        }
+        bits += b0 + b1 + b2 + b3;
     }
-    if (!memcpy((void *)phpack_table_deocde_sorted, (void *)hpack_table, HPACK_BYTES)) {
-        free(phpack_table_deocde_sorted);
-        return HUFFMAN_INIT_ERROR;
+    if (bits > limit) return bits;
+    for (; i < inlen; i++) bits += codes[input[i]].bits;
+    return bits;
+}
+
+static inline uint64_t huffman_encoded_bits( const struct _hpack_table *codes, const uint8_t *input, int inlen ) {
+    return huffman_encoded_bits_limited(codes, input, inlen, UINT64_MAX);
+}
+
+/*
+ * Bit writer shared by the encoders.  Codes collect in a 64-bit
+ * accumulator and leave it 32 bits at a time in network order, so 'out'
+ * never runs past 'end', the exact encoded size.
+ */
+struct _huffman_bitwriter {
+    uint8_t *out;
+    uint8_t *end;
+    uint64_t acc;
+    int nbits;
+};
+
+/*
+ * Appends the low 'bits' (at most 32) bits of 'value'.
+ */
+static inline void huffman_put_bits( struct _huffman_bitwriter *bw, uint32_t value, int bits ) {
+    bw->acc = (bw->acc << bits) | value;
+    bw->nbits += bits;
+    if (bw->nbits >= 32) {
+        bw->nbits -= 32;
+        huffman_store_be32(bw->out, (uint32_t)(bw->acc >> bw->nbits));
+        bw->out += 4;
     }
-    qsort(phpack_table_deocde_sorted, HPACK_SIZE, HPACK_LEN, &sort_hpack_by_freq );
-    return HUFFMAN_SUCCESS;
 }
 
-inline int sort_hpack_by_freq( const void *a, const void *b) {
-    return ((struct _hpack_table *)a)->bits - ((struct _hpack_table *)b)->bits;
+static inline void huffman_put( const struct _hpack_table *codes, struct _huffman_bitwriter *bw, uint8_t c ) {
+    huffman_put_bits(bw, codes[c].value, (int)codes[c].bits);
+}
+
+/*
+ * huffman_put_bits() without the branch on a full word, whose outcome is
+ * as random as the code lengths.  The word is stored every time and 'out'
+ * only advances when it was complete; a store that did not count is
+ * overwritten later.  Needs at least 4 octets between 'out' and 'end'.
+ */
+static inline void huffman_put_bits_fast( struct _huffman_bitwriter *bw, uint32_t value, int bits ) {
+    int full = 0;
+    
+    bw->acc = (bw->acc << bits) | value;
+    bw->nbits += bits;
+    full = bw->nbits >> 5;
+    bw->nbits -= full << 5;
+    huffman_store_be32(bw->out, (uint32_t)(bw->acc >> bw->nbits));
+    bw->out += full << 2;
+}
+
+static inline void huffman_put_fast( const struct _hpack_table *codes, struct _huffman_bitwriter *bw, uint8_t c ) {
+    huffman_put_bits_fast(bw, codes[c].value, (int)codes[c].bits);
+}
+
+#if HUFFMAN_HAVE_AVX2
+static inline void huffman_store_be64( uint8_t *p, uint64_t v ) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+/*
+ * Wide writer used inside the SIMD kernel.  'top' holds 'used' (< 8)
+ * pending bits at its most significant end, so up to 56 bits go in per
+ * call; all 8 octets are stored and 'out' moves past the complete ones.
+ */
+static inline void huffman_put_wide( uint64_t *top, int *used, uint8_t **out, uint64_t value, int bits ) {
+    if (bits > 56) {
+        huffman_put_wide(top, used, out, value >> 32, bits - 32);
+        value &= 0xffffffff;
+        bits = 32;
+    }
+    *top |= value << (64 - *used - bits);
+    *used += bits;
+    huffman_store_be64(*out, *top);
+    *out += *used >> 3;
+    *top <<= *used & ~7;
+    *used &= 7;
+}
+
+/*
+ * AVX2 encode kernel.  Each step gathers the {code, length} entries of 8
+ * input octets as 64-bit lanes, even octets in one register and odd ones
+ * in another, and merges neighbours in a tree, which is the prefix sum
+ * of their lengths: pairs become one code of up to 60 bits per lane,
+ * then quads in lanes 0 and 2, then all 8 in lane 0.  Only that one word
+ * leaves the vector unit and the wide writer takes it in a single store;
+ * a step over 56 bits (long codes) writes its 4 pairs instead.  Built
+ * with BMI2 as well for the writer's variable shifts.  Stops while there
+ * is still room for the worst case of a step (8 x 30 bits plus the
+ * 8-octet store) before 'end'.  Returns the number of octets consumed;
+ * the caller encodes the rest.
+ */
+__attribute__((target("avx2,bmi2")))
+static int huffman_encode_avx2( const struct _hpack_table *table, struct _huffman_bitwriter *bw, const uint8_t *input, int inlen ) {
+    const long long *entries = (const long long *)&table[0].value;
+    const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 1, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i stride = _mm_set1_epi32(sizeof(struct _hpack_table) / sizeof(uint32_t));
+    const __m256i low = _mm256_set1_epi64x(0xffffffff);
+    __m128i octets;
+    __m256i even, odd, odd_len, pc, pl, pc_hi, pl_hi, qc, ql, qc_hi, ql_hi;
+    uint64_t pair[4], pair_len[4], top = 0, bits = 0;
+    uint8_t *out = bw->out;
+    int i = 0, k = 0, used = 0;
+    
+    if (bw->end - out < 40) return 0;
+    
+    /* Switch the pending bits over to the wide writer */
+    top = bw->nbits ? bw->acc << (64 - bw->nbits) : 0;
+    used = bw->nbits;
+    huffman_store_be64(out, top);
+    out += used >> 3;
+    top <<= used & ~7;
+    used &= 7;
+    
+    for (i = 0; i + 8 <= inlen && bw->end - out >= 40; i += 8) {
+        /* value is the low and bits the high half of each gathered lane */
+        octets = _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)(input + i)), split);
+        even = _mm256_i32gather_epi64(entries, _mm_mullo_epi32(_mm_cvtepu8_epi32(octets), stride), 4);
+        odd = _mm256_i32gather_epi64(entries, _mm_mullo_epi32(_mm_cvtepu8_epi32(_mm_srli_si128(octets, 4)), stride), 4);
+        
+        /* Pairs: (even << len(odd)) | odd */
+        odd_len = _mm256_srli_epi64(odd, 32);
+        pc = _mm256_or_si256(_mm256_sllv_epi64(_mm256_and_si256(even, low), odd_len), _mm256_and_si256(odd, low));
+        pl = _mm256_add_epi64(_mm256_srli_epi64(even, 32), odd_len);
+        
+        /* Quads: pair 0 with pair 1 and pair 2 with pair 3, in lanes 0 and 2 */
+        pc_hi = _mm256_srli_si256(pc, 8);
+        pl_hi = _mm256_srli_si256(pl, 8);
+        qc = _mm256_or_si256(_mm256_sllv_epi64(pc, pl_hi), pc_hi);
+        ql = _mm256_add_epi64(pl, pl_hi);
+        
+        /* All 8: lane 2 joins lane 0 */
+        qc_hi = _mm256_permute4x64_epi64(qc, 0x02);
+        ql_hi = _mm256_permute4x64_epi64(ql, 0x02);
+        bits = (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(_mm256_add_epi64(ql, ql_hi)));
+        if (bits <= 56) {
+            huffman_put_wide(&top, &used, &out, (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(_mm256_or_si256(_mm256_sllv_epi64(qc, ql_hi), qc_hi))), (int)bits);
+            continue;
+        }
+        _mm256_storeu_si256((__m256i *)pair, pc);
+        _mm256_storeu_si256((__m256i *)pair_len, pl);
+        for (k = 0; k < 4; k++) huffman_put_wide(&top, &used, &out, pair[k], (int)pair_len[k]);
+    }
+    
+    bw->acc = used ? top >> (64 - used) : 0;
+    bw->nbits = used;
+    bw->out = out;
+    return i;
+}
+
+/*
+ * AVX2 length kernel: gathers the code lengths of a block of octets into
+ * 32-bit lanes, 8 at a time, and folds them into 'bits' once per block.
+ * Returns the number of octets summed.
+ */
+__attribute__((target("avx2")))
+static int huffman_encoded_bits_avx2( const struct _hpack_table *codes, const uint8_t *input, int inlen, uint64_t limit, uint64_t *bits ) {
+    const int *lens = (const int *)&codes[0].bits;
+    const __m256i stride = _mm256_set1_epi32(sizeof(struct _hpack_table) / sizeof(uint32_t));
+    __m256i s0, s1;
+    __m128i h;
+    uint64_t total = *bits;
+    int i = 0;
+    
+#define HUFFMAN_GATHER_LENS(p) _mm256_i32gather_epi32(lens, _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(p))), stride), 4)
+    for (i = 0; i + HUFFMAN_LENGTH_BLOCK <= inlen && total <= limit; i += HUFFMAN_LENGTH_BLOCK) {
+        s0 = _mm256_add_epi32(HUFFMAN_GATHER_LENS(input + i), HUFFMAN_GATHER_LENS(input + i + 8));
+        s1 = _mm256_add_epi32(HUFFMAN_GATHER_LENS(input + i + 16), HUFFMAN_GATHER_LENS(input + i + 24));
+        s0 = _mm256_add_epi32(s0, s1);
+        h = _mm_add_epi32(_mm256_castsi256_si128(s0), _mm256_extracti128_si256(s0, 1));
+        h = _mm_add_epi32(h, _mm_shuffle_epi32(h, 0x4e));
+        h = _mm_add_epi32(h, _mm_shuffle_epi32(h, 0xb1));
+        total += (uint32_t)_mm_cvtsi128_si32(h);
+    }
+#undef HUFFMAN_GATHER_LENS
+    *bits = total;
+    return i;
+}
+#endif
+
+/*
+ * Picks the widest length kernel this CPU runs, in the same way as
+ * huffman_encode_simd() below.
+ */
+static int huffman_encoded_bits_simd( const struct _hpack_table *codes, const uint8_t *input, int inlen, uint64_t limit, uint64_t *bits ) {
+#if HUFFMAN_HAVE_AVX2
+    if (inlen >= HUFFMAN_SIMD_MIN_LENGTH && __builtin_cpu_supports("avx2")) return huffman_encoded_bits_avx2(codes, input, inlen, limit, bits);
+#else
+    (void)codes; (void)input; (void)inlen; (void)limit; (void)bits;
+#endif
+    return 0;
+}
+
+/*
+ * Picks the widest encode kernel this CPU runs.  __builtin_cpu_supports()
+ * only reads data libgcc fills in before main(), so this is cheap enough
+ * to ask on every call and needs no lazily initialized function pointer.
+ * Callers size 'bw' to the exact encoded length, so the room left is the
+ * average code length ahead: when input octets take more than one octet
+ * each, most AVX2 steps would fall back to pairs, which is slower than
+ * the scalar loop.
+ */
+static inline int huffman_encode_simd( const struct _hpack_table *codes, struct _huffman_bitwriter *bw, const uint8_t *input, int inlen ) {
+#if HUFFMAN_HAVE_AVX2
+    if (inlen >= HUFFMAN_SIMD_MIN_LENGTH && bw->end - bw->out <= inlen
+            && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) return huffman_encode_avx2(codes, bw, input, inlen);
+#else
+    (void)codes; (void)bw; (void)input; (void)inlen;
+#endif
+    return 0;
+}
+
+/*
+ * Writes the pending bits, padding the last partial octet with the high
+ * bits of EOS (all ones).
+ */
+static inline void huffman_flush( struct _huffman_bitwriter *bw ) {
+    if (bw->nbits % 8) {
+        bw->acc = (bw->acc << (8 - (bw->nbits % 8))) | (0xff >> (bw->nbits % 8));
+        bw->nbits += 8 - (bw->nbits % 8);
+    }
+    while (bw->nbits) {
+        bw->nbits -= 8;
+        *bw->out++ = (uint8_t)(bw->acc >> bw->nbits);
+    }
+}
+
+/*
+ * Packs the codes for 'input' after whatever 'bw' already holds, through
+ * the widest kernel available, and pads the end.  huffman_encode_run()
+ * does the same for a whole string into 'ob', which must be exactly
+ * (huffman_encoded_bits() + 7) / 8 = 'oblen' octets.
+ */
+static void huffman_encode_rest( const struct _hpack_table *codes, struct _huffman_bitwriter *bw, const uint8_t *input, int inlen ) {
+    struct _huffman_bitwriter w = *bw;                  /* Local copy: stores to 'out' cannot alias it */
+    int i = huffman_encode_simd(codes, &w, input, inlen);
+    
+    for (; i < inlen && w.end - w.out >= 4; i++) huffman_put_fast(codes, &w, input[i]);
+    for (; i < inlen; i++) huffman_put(codes, &w, input[i]);
+    huffman_flush(&w);
+    *bw = w;
+}
+
+static void huffman_encode_run( const struct _hpack_table *codes, const uint8_t *input, int inlen, uint8_t *ob, int oblen ) {
+    struct _huffman_bitwriter bw = { ob, ob + oblen, 0, 0 };
+    
+    huffman_encode_rest(codes, &bw, input, inlen);
 }
 
 uint8_t *compress(const uint8_t *input, int inlen, int *outlen) {
-    int i = 0, block = 0;
-    unsigned long long bits_set = 0, bits_left = 0, bits_this_pass = 0;
-    uint8_t *swap = 0, *ob = 0, val_to_write = 0;
-    size_t len = 0, rmd = 0;
-    const struct _hpack_table *tbl = 0;
+    uint8_t *ob = 0;
+    size_t len = 0;
+    HUFFMAN_STAT_TIMER(t0);
     if (!outlen) return 0;
     *outlen = 0;
     if (!input || inlen <= 0) return 0;
-    len = (int)((double)inlen * (double)1.25); /* Allocate 25% more space as a guesstimate */
     
-    rmd = len%4;
-    if (rmd) len+=(4-rmd);
+    len = (size_t)((huffman_encoded_bits(hpack_table, input, inlen) + 7) / 8);
     ob = (uint8_t *)malloc( len );
+    if (!ob) {
+        (void)HUFFMAN_STAT_FAIL(HUFFMAN_NO_MEMORY);
+        return 0;
+    }
+    HUFFMAN_STAT_ALLOC();
     
-    huffman_zero_mem(ob, len);
-    
-    for (i=0; i < inlen; i++) {
-        tbl = &hpack_table[input[i]];
-        bits_left = tbl->bits;
-        do {
-            block = (bits_set/8);
-            if (block==len) {
-                swap = (uint8_t *)realloc(ob, len+100);
-                if (!swap) {
-                    free(ob);
-                    *outlen = 0;
-                    return 0;
-                }
-                huffman_zero_mem(swap+len, 100);
-                len+=100;
-                ob=swap;
-            }
-            rmd = (bits_set % 8);
-            bits_this_pass = ((bits_left <= (8-rmd))?bits_left:(8-rmd));
-            val_to_write = (uint32_t)(tbl->value >> (bits_left-bits_this_pass));
-            val_to_write<<=((8-bits_this_pass)-rmd);
-            ob[block]|=val_to_write;
-            bits_set+=bits_this_pass;
-            bits_left = bits_left - bits_this_pass;
-        } while (bits_left);
-        if (i == inlen-1) {
-            rmd = bits_set%8;
-            if (rmd) {
-                rmd = 8-rmd;
-                ob[block]|=0xff >> (8-rmd);
-            }
-            *outlen = (block+1);
+    huffman_encode_run(hpack_table, input, inlen, ob, (int)len);
+    *outlen = (int)len;
+    HUFFMAN_STAT_ENCODED(input, inlen, (int)len);
+    HUFFMAN_STAT_ENCODE_TIME(t0);
+    return ob;
+}
+
+
+/*
+ * Bit reader shared by the decoders.  'acc' holds 'avail' valid bits
+ * starting at its most significant bit; bits below them are either zero
+ * or the true bits that follow.
+ */
+struct _huffman_bitreader {
+    const uint8_t *input;
+    int inlen;
+    int pos;
+    int avail;
+    uint64_t acc;
+};
+
+/*
+ * Tops the bit buffer up so a whole 30-bit code is in view whenever the
+ * input still has that many bits left.
+ */
+static inline void huffman_refill( struct _huffman_bitreader *br ) {
+    int n = 0;
+    
+    if (br->avail >= 32) return;
+    if (br->inlen - br->pos >= 8) {
+        br->acc |= huffman_load_be64(br->input + br->pos) >> br->avail;
+        n = (63 - br->avail) >> 3;
+        br->pos += n;
+        br->avail += n << 3;
+    } else {
+        while (br->avail <= 56 && br->pos < br->inlen) {
+            br->acc |= (uint64_t)br->input[br->pos++] << (56 - br->avail);
+            br->avail += 8;
         }
     }
-    return ob;
 }
 
+/*
+ * Walks the decode table for the code at the top of 'acc'.  The entry's
+ * 'bits' is the code length; it is larger than any bit count for the
+ * unused patterns of an incomplete code.
+ */
+static inline const struct _huffman_decode_entry *huffman_lookup( const struct _huffman_decode_entry *tbl, uint64_t acc ) {
+    const struct _huffman_decode_entry *e = &tbl[acc >> (64 - HUFFMAN_DECODE_ROOT_BITS)];
+    int used = HUFFMAN_DECODE_ROOT_BITS, width = 0;
+    
+    while (e->flags & HUFFMAN_DECODE_LINK) {
+        width = e->bits;
+        e = &tbl[e->next + (int)((acc << used) >> (64 - width))];
+        used += width;
+    }
+    return e;
+}
+
+/*
+ * Decodes the bits in 'br' into 'ob', one table walk per symbol.  Stops
+ * at the EOS symbol or when the remaining bits are too short to form a
+ * code, leaving those bits in 'br'.  At most 'obcap' octets are stored,
+ * but every symbol is counted, so the return value is the full decoded
+ * length.
+ */
+static int huffman_decode_run( const struct _huffman_decode_entry *tbl, struct _huffman_bitreader *br, char *ob, int obcap ) {
+    struct _huffman_bitreader r = *br;                  /* Local copy: stores to 'ob' cannot alias it */
+    const struct _huffman_decode_entry *e = 0;
+    int written = 0;
+    
+    for (;;) {
+        huffman_refill(&r);
+        if (!r.avail) break;
+        e = huffman_lookup(tbl, r.acc);
+        if (e->bits > r.avail || e->next == HPACK_EOS) break;
+        if (written < obcap) ob[written] = (char)e->next;
+        written++;
+        r.acc <<= e->bits;
+        r.avail -= e->bits;
+    }
+    *br = r;
+    return written;
+}
+
+/*
+ * Classifies the bits huffman_decode_run() left behind: an EOS symbol, or
+ * padding that must be at most 7 bits of ones (RFC 7541, section 5.2).
+ */
+static int huffman_check_tail( const struct _huffman_decode_entry *tbl, const struct _huffman_bitreader *br ) {
+    const struct _huffman_decode_entry *e = 0;
+    uint64_t ones = 0;
+    
+    if (!br->avail) return HUFFMAN_SUCCESS;
+    e = huffman_lookup(tbl, br->acc);
+    if (e->next == HPACK_EOS && e->bits <= br->avail) return HUFFMAN_EOS_DECODED;
+    ones = ~(uint64_t)0 << (64 - br->avail);
+    if ((br->acc & ones) != ones) return HUFFMAN_PADDING_INVALID;
+    if (br->avail > 7) return HUFFMAN_PADDING_TOO_LONG;
+    return HUFFMAN_SUCCESS;
+}
+
+/*
+ * The one-shot decoders accept whatever ends the input, as they always
+ * have.  With stats enabled the ending is still classified so malformed
+ * strings show up in the error counts.
+ */
+#ifdef HUFFMAN_STATS
+#define HUFFMAN_STAT_TAIL(br) do { int rc_ = huffman_check_tail(huffman_decode_table, (br)); if (rc_ < 0) huffman_stats_error(rc_); } while (0)
+#else
+#define HUFFMAN_STAT_TAIL(br) do { } while (0)
+#endif
+
+int huffman_encode(const uint8_t *input, int inlen, uint8_t *output, int outcap) {
+    uint64_t bits = 0;
+    int len = 0;
+    
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    bits = huffman_encoded_bits(hpack_table, input, inlen);
+    if (bits > (uint64_t)INT32_MAX * 8) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    len = (int)((bits + 7) / 8);
+    if (output && len <= outcap) {
+        huffman_encode_run(hpack_table, input, inlen, output, len);
+        HUFFMAN_STAT_ENCODED(input, inlen, len);
+        HUFFMAN_STAT_ENCODE_TIME(t0);
+    }
+    return len;
+}
+
+int huffman_encoded_length(const uint8_t *input, int inlen, int limit) {
+    uint64_t bits = 0;
+    
+    if (inlen < 0 || (!input && inlen)) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    bits = huffman_encoded_bits_limited(hpack_table, input, inlen, (limit >= 0) ? (uint64_t)limit * 8 : UINT64_MAX);
+    if (bits > (uint64_t)INT32_MAX * 8) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    if (limit >= 0 && bits > (uint64_t)limit * 8) return limit + 1;
+    return (int)((bits + 7) / 8);
+}
+
+int huffman_encode_if_shorter(const uint8_t *input, int inlen, uint8_t *output, int outcap, int *huffman) {
+    uint64_t bits = 0;
+    int len = 0;
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (inlen < 0 || (!input && inlen) || outcap < 0 || !huffman) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    
+    /* Anything over inlen - 1 octets goes out raw, so stop counting there */
+    bits = huffman_encoded_bits_limited(hpack_table, input, inlen, inlen ? (uint64_t)(inlen - 1) * 8 : 0);
+    len = (int)((bits + 7) / 8);
+    if (len >= inlen) {
+        *huffman = 0;
+        if (output && inlen <= outcap && inlen) memcpy(output, input, inlen);
+        return inlen;
+    }
+    *huffman = 1;
+    if (output && len <= outcap) {
+        huffman_encode_run(hpack_table, input, inlen, output, len);
+        HUFFMAN_STAT_ENCODED(input, inlen, len);
+        HUFFMAN_STAT_ENCODE_TIME(t0);
+    }
+    return len;
+}
+
+int huffman_decode(const uint8_t *input, int inlen, char *output, int outcap) {
+    struct _huffman_bitreader br = { 0, 0, 0, 0, 0 };
+    int written = 0;
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    br.input = input;
+    br.inlen = inlen;
+    written = huffman_decode_run(huffman_decode_table, &br, output, output ? outcap : 0);
+    
+    /* Size queries and short buffers get called again, so only count the pass that stores */
+    if (output && written <= outcap) {
+        HUFFMAN_STAT_TAIL(&br);
+        HUFFMAN_STAT_DECODED(output, written, inlen, 1);
+        HUFFMAN_STAT_DECODE_TIME(t0);
+    }
+    return written;
+}
+
+/*
+ * Trained codes run through the same kernels with their own tables; the
+ * rest of a codebook's life is in huffman_codebook.c.
+ */
+int huffman_codebook_encode(const struct huffman_codebook *cb, const uint8_t *input, int inlen, uint8_t *output, int outcap) {
+    uint64_t bits = 0;
+    int len = 0;
+    
+    if (!cb || inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    bits = huffman_encoded_bits(cb->codes, input, inlen);
+    if (bits > (uint64_t)INT32_MAX * 8) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    len = (int)((bits + 7) / 8);
+    if (output && len <= outcap) huffman_encode_run(cb->codes, input, inlen, output, len);
+    return len;
+}
+
+int huffman_codebook_decode(const struct huffman_codebook *cb, const uint8_t *input, int inlen, char *output, int outcap) {
+    struct _huffman_bitreader br = { 0, 0, 0, 0, 0 };
+    
+    if (!cb || inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    br.input = input;
+    br.inlen = inlen;
+    return huffman_decode_run(cb->decode, &br, output, output ? outcap : 0);
+}
 
 int decompress(const uint8_t *input, int inlen, char **output, int outlen) {
-    uint8_t  _char = 0;
-    uint16_t _short = 0;
-    uint32_t _long = 0;
-    int i = 0;
-    int charpos = 0;
-    int bits_done = 0;
-    int bit_offset = 0;
-    int bits_left = 0;
-    int bits_total = (inlen*8);
-    size_t written = 0;
+    int64_t bound = 0;
+    int written = 0;
     char *ob = *output, *swap = 0;
     
-    if (!phpack_table_deocde_sorted) {
-        if (!prep_hpack_compression()) return HUFFMAN_INIT_ERROR;
+    if (!input || inlen < 0) inlen = 0;
+    if (!ob) {
+        bound = (((int64_t)inlen * 8) / 5) + 1;         /* Shortest code is 5 bits, plus the terminator */
+        if (bound > INT32_MAX) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+        outlen = (int)bound;
+        ob = (char *)malloc(outlen);
+        if (!ob) return HUFFMAN_STAT_FAIL(HUFFMAN_NO_MEMORY);
+        HUFFMAN_STAT_ALLOC();
+        *output = ob;
     }
     
-    if (!ob) {
-        outlen = inlen*2;
-        ob = (char *)malloc(inlen*2);
+    written = huffman_decode(input, inlen, ob, (outlen > 0) ? outlen - 1 : 0);
+    if (written < 0) return written;
+    if (written >= outlen) {                            /* Too small: grow to the exact size and go again */
+        swap = (char *)realloc(ob, (size_t)written + 1);
+        if (!swap) return HUFFMAN_STAT_FAIL(HUFFMAN_NO_MEMORY);
+        HUFFMAN_STAT_REALLOC();
+        ob = swap;
         *output = ob;
+        huffman_decode(input, inlen, ob, written);
     }
+    ob[written] = 0;
+    return written;
+}
+
+int huffman_decoder_init(struct huffman_decoder *d) {
+    if (!d) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    d->acc = 0;
+    d->avail = 0;
+    d->error = 0;
+    return HUFFMAN_SUCCESS;
+}
+
+int huffman_decoder_feed(struct huffman_decoder *d, const uint8_t *input, int inlen, char *output, int outcap) {
+    struct _huffman_bitreader br = { 0, 0, 0, 0, 0 };
+    int written = 0;
     
-    while (bits_done < bits_total) {
-        charpos = bits_done/8;
-        bit_offset = bits_done%8;
-        bits_left = bits_total - bits_done;
-        for (i = 0; i < HPACK_SIZE; i++) {
-            if (bits_left < phpack_table_deocde_sorted[i].bits) {      /* We have fewer bits left than 
-                                                                        * from this point in the huffman 
-                                                                        * array going forward.  No need 
-                                                                        * in continuing since it's 
-                                                                        * sorted lowest to highest. This
-                                                                        * means we're done decoding.
-                                                                        */
-                ob[written] = 0;
-                return (int)written;
-            }
-            if (written > outlen) { /* Check that we have enough space to populate the output buffer */
-                swap = (char *)realloc(ob, outlen+1000);
-                if (!swap) {
-                    ob[written-1] = 0;
-                    return HUFFMAN_NO_MEMORY; /* Out of memory! */
-                }
-                ob = swap;
-                *output = ob;
-            }
-            if (phpack_table_deocde_sorted[i].bits <= 8) {
-                /* 8 - bits */
-                _char = input[charpos];
-                _char <<= bit_offset;
-                if (charpos+1 <= inlen) {
-                    _char|=input[charpos+1]>>(8-bit_offset);
-                }
-                if ( (_char >> (8-phpack_table_deocde_sorted[i].bits) == phpack_table_deocde_sorted[i].value)) {
-                    ob[written++] = (char)phpack_table_deocde_sorted[i].charval;
-                    bits_done+=phpack_table_deocde_sorted[i].bits;
-                    break;
-                }
-            } else if (phpack_table_deocde_sorted[i].bits <= 16) {
-                /* 16 bits */
-                _short = ntohs(*(uint16_t *)&input[charpos]);
-                _short <<= bit_offset;
-                if (charpos+2 <= inlen) {
-                    _short|=ntohs(*(uint16_t *)&input[charpos+2])>>(16-bit_offset);
-                }
-                if ( (_short >> (16-phpack_table_deocde_sorted[i].bits) == phpack_table_deocde_sorted[i].value)) {
-                    ob[written++] = (char)phpack_table_deocde_sorted[i].charval;
-                    bits_done+=phpack_table_deocde_sorted[i].bits;
-                    break;
-                }
-                
-            } else if (phpack_table_deocde_sorted[i].bits <= 32) {
-                /* 32 bits */
-                _long = ntohl(*(uint32_t *)&input[charpos]);
-                _long <<= bit_offset;
-                if (charpos+4 <= inlen) {
-                    _long|=ntohl(*(uint32_t *)&input[charpos+4])>>(32-bit_offset);
-                }
-                if ( (_long >> (32-phpack_table_deocde_sorted[i].bits) == phpack_table_deocde_sorted[i].value)) {
-                    ob[written++] = (char)phpack_table_deocde_sorted[i].charval;
-                    bits_done+=phpack_table_deocde_sorted[i].bits;
-                    break;
-                }
-            } else {
-                return HUFFMAN_INTERNAL_ERROR;
+    if (!d || inlen < 0 || (!input && inlen) || (!output && inlen)) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    if (d->error) return d->error;
+    if (outcap < HUFFMAN_DECODER_BOUND(inlen)) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    
+    br.input = input;
+    br.inlen = inlen;
+    br.avail = d->avail;
+    br.acc = d->acc;
+    written = huffman_decode_run(huffman_decode_table, &br, output, outcap);
+    
+    /* Whatever is left is shorter than its code unless EOS stopped us */
+    if (huffman_check_tail(huffman_decode_table, &br) == HUFFMAN_EOS_DECODED) {
+        d->error = HUFFMAN_STAT_FAIL(HUFFMAN_EOS_DECODED);
+        return d->error;
+    }
+    d->avail = br.avail;
+    d->acc = br.acc;
+    HUFFMAN_STAT_DECODED(output, written, inlen, 0);    /* The string is counted once, by finish */
+    return written;
+}
+
+int huffman_decoder_finish(struct huffman_decoder *d) {
+    struct _huffman_bitreader br = { 0, 0, 0, 0, 0 };
+    int rc = 0;
+    
+    if (!d) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    if (d->error) return d->error;
+    br.avail = d->avail;
+    br.acc = d->acc;
+    rc = huffman_check_tail(huffman_decode_table, &br);
+    if (rc != HUFFMAN_SUCCESS) d->error = HUFFMAN_STAT_FAIL(rc);
+    else HUFFMAN_STAT_DECODED(0, 0, 0, 1);
+    return rc;
+}
+
+/*
+ * Octet classes for huffman_decode_checked().  Field names (RFC 9113,
+ * section 8.2.1) may not hold controls, SP, DEL, non-ASCII or uppercase
+ * octets, and a colon only opens a pseudo-header name.  Field values may
+ * not hold NUL, LF or CR; the whitespace rule for their ends is checked
+ * on the first and last octet.
+ */
+#define HUFFMAN_CLASS_INVALID 0x01
+#define HUFFMAN_CLASS_UPPER 0x02
+#define HUFFMAN_CLASS_COLON 0x04
+
+static const uint8_t huffman_name_class[256] = {
+    [0x00 ... 0x20] = HUFFMAN_CLASS_INVALID,
+    [':'] = HUFFMAN_CLASS_COLON,
+    ['A' ... 'Z'] = HUFFMAN_CLASS_UPPER,
+    [0x7f ... 0xff] = HUFFMAN_CLASS_INVALID
+};
+
+static const uint8_t huffman_value_class[256] = {
+    [0x00] = HUFFMAN_CLASS_INVALID,
+    ['\n'] = HUFFMAN_CLASS_INVALID,
+    ['\r'] = HUFFMAN_CLASS_INVALID
+};
+
+static const uint8_t huffman_no_class[256] = { 0 };
+
+/* CRC-32C (Castagnoli, reflected 0x82f63b78), one octet per step */
+static const uint32_t huffman_crc32c_table[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+    0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+    0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+    0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+    0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+    0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+    0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+    0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+    0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+    0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+    0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+    0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+    0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+    0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+    0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+    0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+    0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+    0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+    0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+    0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+    0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+    0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+/*
+ * huffman_decode_run() that also classifies and hashes every symbol as
+ * it comes out, so the string is never read a second time.  'hash' is a
+ * constant at each call site, which lets the compiler drop the other
+ * cases from the loop.  The first octet with a class other than an
+ * opening colon is recorded in 'bad' and 'bad_class'; 'ends' receives
+ * the first and last octets.
+ */
+static inline int huffman_decode_checked_run( struct _huffman_bitreader *br, char *ob, int obcap, const uint8_t *cls, int hash, uint64_t *h, int *bad, int *bad_class, int *ends ) {
+    struct _huffman_bitreader r = *br;
+    const struct _huffman_decode_entry *e = 0;
+    uint64_t v = *h;
+    int written = 0, c = 0, k = 0;
+    
+    for (;;) {
+        huffman_refill(&r);
+        if (!r.avail) break;
+        e = huffman_lookup(huffman_decode_table, r.acc);
+        if (e->bits > r.avail || e->next == HPACK_EOS) break;
+        c = e->next;
+        if (written < obcap) ob[written] = (char)c;
+        k = cls[c];
+        if (k && !(k == HUFFMAN_CLASS_COLON && !written) && *bad < 0) {
+            *bad = written;
+            *bad_class = k;
+        }
+        switch (hash) {
+        case HUFFMAN_HASH_FNV1A_32: v = (uint32_t)((v ^ (uint64_t)c) * 16777619u); break;
+        case HUFFMAN_HASH_FNV1A_64: v = (v ^ (uint64_t)c) * 1099511628211ULL; break;
+        case HUFFMAN_HASH_CRC32C: v = (v >> 8) ^ huffman_crc32c_table[(v ^ (uint64_t)c) & 0xff]; break;
+        default: break;
+        }
+        if (!written) ends[0] = c;
+        ends[1] = c;
+        written++;
+        r.acc <<= e->bits;
+        r.avail -= e->bits;
+    }
+    *br = r;
+    *h = v;
+    return written;
+}
+
+int huffman_decode_checked(const uint8_t *input, int inlen, char *output, int outcap, struct huffman_check *check) {
+    struct _huffman_bitreader br = { 0, 0, 0, 0, 0 };
+    const uint8_t *cls = huffman_no_class;
+    uint64_t h = 0;
+    int written = 0, bad = -1, bad_class = 0, ends[2] = { -1, -1 }, rc = 0;
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (!check || inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    if (check->validate == HUFFMAN_VALIDATE_NAME) cls = huffman_name_class;
+    else if (check->validate == HUFFMAN_VALIDATE_VALUE) cls = huffman_value_class;
+    else if (check->validate) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    switch (check->hash) {
+    case HUFFMAN_HASH_NONE: h = 0; break;
+    case HUFFMAN_HASH_FNV1A_32: h = 2166136261u ^ (uint32_t)check->seed; break;
+    case HUFFMAN_HASH_FNV1A_64: h = 14695981039346656037ULL ^ check->seed; break;
+    case HUFFMAN_HASH_CRC32C: h = 0xffffffffu ^ (uint32_t)check->seed; break;
+    default: return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    }
+    check->hash_value = 0;
+    check->error_offset = -1;
+    
+    br.input = input;
+    br.inlen = inlen;
+    if (!output) outcap = 0;
+    switch (check->hash) {
+    case HUFFMAN_HASH_FNV1A_32: written = huffman_decode_checked_run(&br, output, outcap, cls, HUFFMAN_HASH_FNV1A_32, &h, &bad, &bad_class, ends); break;
+    case HUFFMAN_HASH_FNV1A_64: written = huffman_decode_checked_run(&br, output, outcap, cls, HUFFMAN_HASH_FNV1A_64, &h, &bad, &bad_class, ends); break;
+    case HUFFMAN_HASH_CRC32C: written = huffman_decode_checked_run(&br, output, outcap, cls, HUFFMAN_HASH_CRC32C, &h, &bad, &bad_class, ends); break;
+    default: written = huffman_decode_checked_run(&br, output, outcap, cls, HUFFMAN_HASH_NONE, &h, &bad, &bad_class, ends); break;
+    }
+    
+    /* The code itself first: past a bad ending the octets mean nothing */
+    rc = huffman_check_tail(huffman_decode_table, &br);
+    if (rc != HUFFMAN_SUCCESS) {
+        check->error_offset = written;
+        return HUFFMAN_STAT_FAIL(rc);
+    }
+    
+    /* A name is at least one octet; a value neither starts nor ends with SP or HTAB */
+    if (check->validate == HUFFMAN_VALIDATE_NAME && !written) bad = 0;
+    if (check->validate == HUFFMAN_VALIDATE_VALUE && written) {
+        if (ends[0] == ' ' || ends[0] == '\t') bad = 0;
+        else if ((ends[1] == ' ' || ends[1] == '\t') && bad < 0) bad = written - 1;
+    }
+    if (bad >= 0) {
+        check->error_offset = bad;
+        if (check->validate == HUFFMAN_VALIDATE_VALUE) return HUFFMAN_STAT_FAIL(HUFFMAN_VALUE_INVALID);
+        return HUFFMAN_STAT_FAIL((bad_class == HUFFMAN_CLASS_UPPER) ? HUFFMAN_NAME_UPPERCASE : HUFFMAN_NAME_INVALID);
+    }
+    
+    if (check->hash == HUFFMAN_HASH_CRC32C) h ^= 0xffffffffu;
+    check->hash_value = h;
+    if (output && written <= outcap) {
+        HUFFMAN_STAT_DECODED(output, written, inlen, 1);
+        HUFFMAN_STAT_DECODE_TIME(t0);
+    }
+    return written;
+}
+
+/*
+ * Number of strings the batch calls code side by side.  Each lane has its
+ * own bit buffer, so the table lookups and shifts of one string overlap
+ * with those of the others instead of waiting on each other.  The lane
+ * loops are written out by hand for 4 so every lane stays in registers.
+ */
+#define HUFFMAN_BATCH_LANES 4
+
+/*
+ * Decodes HUFFMAN_BATCH_LANES strings in lock step for as long as every
+ * lane has at least 8 octets of input left, which keeps 32 or more bits
+ * in each buffer so no lane can run out mid-code.  Returns as soon as
+ * any lane reaches EOS or an unused pattern; huffman_decode_run() then
+ * finishes each lane from where it stopped.
+ */
+static void huffman_decode_lanes( const struct _huffman_decode_entry *tbl, struct _huffman_bitreader *br, char **ob, int *written ) {
+    struct _huffman_bitreader r0 = br[0], r1 = br[1], r2 = br[2], r3 = br[3];
+    const struct _huffman_decode_entry *e0, *e1, *e2, *e3;
+    char *o0 = ob[0] + written[0], *o1 = ob[1] + written[1], *o2 = ob[2] + written[2], *o3 = ob[3] + written[3];
+    
+    while (r0.inlen - r0.pos >= 8 && r1.inlen - r1.pos >= 8 && r2.inlen - r2.pos >= 8 && r3.inlen - r3.pos >= 8) {
+        huffman_refill(&r0);
+        huffman_refill(&r1);
+        huffman_refill(&r2);
+        huffman_refill(&r3);
+        e0 = huffman_lookup(tbl, r0.acc);
+        e1 = huffman_lookup(tbl, r1.acc);
+        e2 = huffman_lookup(tbl, r2.acc);
+        e3 = huffman_lookup(tbl, r3.acc);
+        if (e0->bits > 30 || e1->bits > 30 || e2->bits > 30 || e3->bits > 30
+                || e0->next == HPACK_EOS || e1->next == HPACK_EOS || e2->next == HPACK_EOS || e3->next == HPACK_EOS) break;
+        *o0++ = (char)e0->next;
+        *o1++ = (char)e1->next;
+        *o2++ = (char)e2->next;
+        *o3++ = (char)e3->next;
+        r0.acc <<= e0->bits; r0.avail -= e0->bits;
+        r1.acc <<= e1->bits; r1.avail -= e1->bits;
+        r2.acc <<= e2->bits; r2.avail -= e2->bits;
+        r3.acc <<= e3->bits; r3.avail -= e3->bits;
+    }
+    br[0] = r0; br[1] = r1; br[2] = r2; br[3] = r3;
+    written[0] = (int)(o0 - ob[0]);
+    written[1] = (int)(o1 - ob[1]);
+    written[2] = (int)(o2 - ob[2]);
+    written[3] = (int)(o3 - ob[3]);
+}
+
+int huffman_decode_batch(const struct huffman_string *inputs, int count, char *output, int outcap, int *offsets) {
+    struct _huffman_bitreader br[HUFFMAN_BATCH_LANES];
+    char *ob[HUFFMAN_BATCH_LANES];
+    int written[HUFFMAN_BATCH_LANES];
+    int64_t bound[HUFFMAN_BATCH_LANES], room = 0;       /* 8/5 of a length over 268 MB does not fit an int */
+    uint64_t total = 0;
+    int i = 0, k = 0, n = 0, pos = 0;
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (count < 0 || (!inputs && count) || !offsets || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    for (i = 0; i < count; i++) {
+        if (inputs[i].len < 0 || (!inputs[i].data && inputs[i].len)) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    }
+    if (!output) outcap = 0;
+    
+    for (i = 0; i < count; i += n) {
+        n = (count - i < HUFFMAN_BATCH_LANES) ? count - i : HUFFMAN_BATCH_LANES;
+        room = 0;
+        for (k = 0; k < n; k++) {
+            bound[k] = ((int64_t)inputs[i+k].len * 8) / 5;
+            room += bound[k];
+            br[k].input = inputs[i+k].data;
+            br[k].inlen = inputs[i+k].len;
+            br[k].pos = br[k].avail = 0;
+            br[k].acc = 0;
+            written[k] = 0;
+        }
+        if (room + (int64_t)total > outcap) {
+            /* Not enough space for every lane's worst case: go one at a time */
+            for (k = 0; k < n; k++) {
+                offsets[i+k] = (int)total;
+                pos = ((uint64_t)outcap > total) ? outcap - (int)total : 0;
+                total += huffman_decode_run(huffman_decode_table, &br[k], output + (pos ? total : 0), pos);
+                if (total > INT32_MAX) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
             }
+            continue;
         }
-        if (i == HPACK_SIZE )  {
-            ob[written] = 0;
-            return (int)written;
+        
+        /* Give each lane its worst-case span, then close the gaps.  They all fit in 'outcap', so each is an int */
+        for (k = 0, pos = (int)total; k < n; pos += (int)bound[k++]) ob[k] = output + pos;
+        if (n == HUFFMAN_BATCH_LANES) huffman_decode_lanes(huffman_decode_table, br, ob, written);
+        for (k = 0; k < n; k++) {
+            written[k] += huffman_decode_run(huffman_decode_table, &br[k], ob[k] + written[k], (int)bound[k] - written[k]);
+            offsets[i+k] = (int)total;
+            if (ob[k] != output + total) memmove(output + total, ob[k], written[k]);
+            total += written[k];
         }
     }
-    ob[written] = 0;
-    return (int)written;
+    offsets[count] = (int)total;
+#ifdef HUFFMAN_STATS
+    if (output && total <= (uint64_t)outcap) {
+        for (i = 0; i < count; i++) HUFFMAN_STAT_DECODED(output + offsets[i], offsets[i+1] - offsets[i], inputs[i].len, 1);
+        HUFFMAN_STAT_DECODE_TIME(t0);
+    }
+#endif
+    return (int)total;
 }
 
+/*
+ * Encoder counterpart of huffman_decode_lanes(): feeds one octet to each
+ * lane per step for as long as all of them have input left.  Strings
+ * long enough for the SIMD kernel are better off going through it one
+ * at a time, so lanes only cover short strings.
+ */
+static void huffman_encode_lanes( const struct huffman_string *inputs, struct _huffman_bitwriter *bw, int *done ) {
+    struct _huffman_bitwriter w0 = bw[0], w1 = bw[1], w2 = bw[2], w3 = bw[3];
+    const uint8_t *s0 = inputs[0].data, *s1 = inputs[1].data, *s2 = inputs[2].data, *s3 = inputs[3].data;
+    int i = 0, k = 0, common = inputs[0].len;
+    
+    for (k = 1; k < HUFFMAN_BATCH_LANES; k++) {
+        if (inputs[k].len < common) common = inputs[k].len;
+    }
+    if (common >= HUFFMAN_SIMD_MIN_LENGTH) return;
+    for (i = 0; i < common; i++) {
+        huffman_put(hpack_table, &w0, s0[i]);
+        huffman_put(hpack_table, &w1, s1[i]);
+        huffman_put(hpack_table, &w2, s2[i]);
+        huffman_put(hpack_table, &w3, s3[i]);
+    }
+    bw[0] = w0; bw[1] = w1; bw[2] = w2; bw[3] = w3;
+    for (k = 0; k < HUFFMAN_BATCH_LANES; k++) done[k] = common;
+}
+
+int huffman_encode_batch(const struct huffman_string *inputs, int count, uint8_t *output, int outcap, int *offsets) {
+    struct _huffman_bitwriter bw[HUFFMAN_BATCH_LANES];
+    int done[HUFFMAN_BATCH_LANES];
+    uint64_t total = 0;
+    int i = 0, k = 0, n = 0;
+    HUFFMAN_STAT_TIMER(t0);
+    
+    if (count < 0 || (!inputs && count) || !offsets || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    for (i = 0; i < count; i++) {
+        if (inputs[i].len < 0 || (!inputs[i].data && inputs[i].len)) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+        offsets[i] = (int)total;
+        total += (huffman_encoded_bits(hpack_table, inputs[i].data, inputs[i].len) + 7) / 8;
+        if (total > INT32_MAX) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    }
+    offsets[count] = (int)total;
+    if (!output || (int)total > outcap) return (int)total;
+    
+    for (i = 0; i < count; i += n) {
+        n = (count - i < HUFFMAN_BATCH_LANES) ? count - i : HUFFMAN_BATCH_LANES;
+        for (k = 0; k < n; k++) {
+            bw[k].out = output + offsets[i+k];
+            bw[k].end = output + offsets[i+k+1];
+            bw[k].acc = 0;
+            bw[k].nbits = 0;
+            done[k] = 0;
+        }
+        if (n == HUFFMAN_BATCH_LANES) huffman_encode_lanes(inputs + i, bw, done);
+        for (k = 0; k < n; k++) huffman_encode_rest(hpack_table, &bw[k], inputs[i+k].data + done[k], inputs[i+k].len - done[k]);
+    }
+#ifdef HUFFMAN_STATS
+    for (i = 0; i < count; i++) HUFFMAN_STAT_ENCODED(inputs[i].data, inputs[i].len, offsets[i+1] - offsets[i]);
+    HUFFMAN_STAT_ENCODE_TIME(t0);
+#endif
+    return (int)total;
+}
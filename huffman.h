@@ -17,96 +17,40 @@ extern "C" {
 #include <string.h>
 #include <arpa/inet.h>
 
+#define HUFFMAN_LOWEST_ERROR -13        /* Keep at the lowest code below; it sizes huffman_stats.errors[] */
+#define HUFFMAN_VALUE_INVALID -13       /* A field value holds NUL, LF or CR, or starts or ends with whitespace */
+#define HUFFMAN_NAME_INVALID -12        /* A field name is empty or holds an octet names may not */
+#define HUFFMAN_NAME_UPPERCASE -11      /* A field name holds an uppercase letter */
+#define HUFFMAN_FRAME_INVALID -10       /* Not a well-formed frame (see huffman_frame_encode()) */
+#define HUFFMAN_EOS_DECODED -7          /* The EOS symbol appeared in the string */
+#define HUFFMAN_PADDING_INVALID -6      /* Padding is not a prefix of EOS (all ones) */
+#define HUFFMAN_PADDING_TOO_LONG -5     /* More than 7 bits of padding */
+#define HUFFMAN_BAD_PARAMETER -4
 #define HUFFMAN_INTERNAL_ERROR -3
 #define HUFFMAN_NO_MEMORY -2
 #define HUFFMAN_INIT_ERROR -1
 #define HUFFMAN_NO_ERROR 0
 #define HUFFMAN_SUCCESS 1
     
-static int huffman_bits = (sizeof(int *) * 8);
-    
-static const struct _hpack_table {
+/* The AVX2 encoder gathers 'value' and 'bits' as one 64-bit word */
+struct _hpack_table {
     uint32_t value;
     uint32_t bits;
     uint32_t charval;
-} hpack_table[] = {
-    {0x1ff8,                13,     0},   {0x7fffd8,              23,     1},   {0x7fffd8,              28,     2},   {0xfffffe3,             28,     3},
-    {0xfffffe4,             28,     4},   {0xfffffe5,             28,     5},   {0xfffffe6,             28,     6},   {0xfffffe7,             28,     7},
-    {0xfffffe8,             28,     8},   {0xffffea,              24,     9},   {0x3ffffffc,            30,     10},  {0xfffffe9,             28,     11},
-    {0xfffffea,             28,     12},  {0x3ffffffd,            30,     13},  {0xfffffeb,             28,     14},  {0xfffffec,             28,     15},
-    {0xfffffed,             28,     16},  {0xfffffee,             28,     17},  {0xfffffef,             28,     18},  {0xffffff0,             28,     19},
-    {0xffffff1,             28,     20},  {0xffffff2,             28,     21},  {0x3ffffffe,            30,     22},  {0xffffff3,             28,     23},
-    {0xffffff4,             28,     24},  {0xffffff5,             28,     25},  {0xffffff6,             28,     26},  {0xffffff7,             28,     27},
-    {0xffffff8,             28,     28},  {0xffffff9,             28,     29},  {0xffffffa,             28,     30},  {0xffffffb,             28,     31},
-    {0x14,                   6,     32},  {0x3f8,                 10,     33},  {0x3f9,                 10,     34},  {0xffa,                 12,     35},
-    {0x1ff9,                13,     36},  {0x15,                   6,     37},  {0xf8,                   8,     38},  {0x7fa,                 11,     39},
-    {0x3fa,                 10,     40},  {0x3fb,                 10,     41},  {0xf9,                   8,     42},  {0x7fb,                 11,     43},
-    {0xfa,                   8,     44},  {0x16,                   6,     45},  {0x17,                   6,     46},  {0x18,                   6,     47}, 
-    {0x0,                    5,     48},  {0x1,                    5,     49},  {0x2,                    5,     50},  {0x19,                   6,     51},
-    {0x1a,                   6,     52},  {0x1b,                   6,     53},  {0x1c,                   6,     54},  {0x1d,                   6,     55},
-    {0x1e,                   6,     56},  {0x1f,                   6,     57},  {0x5c,                   7,     58},  {0xfb,                   8,     59},
-    {0x7ffc,                15,     60},  {0x20,                   6,     61},  {0xffb,                 12,     62},  {0x3fc,                 10,     63},
-    {0x1ffa,                13,     64},  {0x21,                   6,     65},  {0x5d,                   7,     66},  {0x5e,                   7,     67},
-    {0x5f,                   7,     68},  {0x60,                   7,     69},  {0x61,                   7,     70},  {0x62,                   7,     71},
-    {0x63,                   7,     72},  {0x64,                   7,     73},  {0x65,                   7,     74},  {0x66,                   7,     75},
-    {0x67,                   7,     76},  {0x68,                   7,     77},  {0x69,                   7,     78},  {0x6a,                   7,     79},
-    {0x6b,                   7,     80},  {0x6c,                   7,     81},  {0x6d,                   7,     82},  {0x6e,                   7,     83},
-    {0x6f,                   7,     84},  {0x70,                   7,     85},  {0x71,                   7,     86},  {0x72,                   7,     87},
-    {0xfc,                   8,     88},  {0x73,                   7,     89},  {0xfd,                   8,     90},  {0x1ffb,                13,     91},
-    {0x7fff0,               19,     92},  {0x1ffc,                13,     93},  {0x3ffc,                14,     94},  {0x22,                   6,     95},
-    {0x7ffd,                15,     96},  {0x3,                    5,     97},  {0x23,                   6,     98},  {0x4,                    5,     99},
-    {0x24,                   6,     100}, {0x5,                    5,     101}, {0x25,                   6,     102}, {0x26,                   6,     103},
-    {0x27,                   6,     104}, {0x6,                    5,     105}, {0x74,                   7,     106}, {0x75,                   7,     107},
-    {0x28,                   6,     108}, {0x29,                   6,     109}, {0x2a,                   6,     110}, {0x7,                    5,     111},
-    {0x2b,                   6,     112}, {0x76,                   7,     113}, {0x2c,                   6,     114}, {0x8,                    5,     115},
-    {0x9,                    5,     116}, {0x2d,                   6,     117}, {0x77,                   7,     118}, {0x78,                   7,     119},
-    {0x79,                   7,     120}, {0x7a,                   7,     121}, {0x7b,                   7,     122}, {0x7ffe,                15,     123},
-    {0x7fc,                 11,     124}, {0x3ffd,                14,     125}, {0x1ffd,                13,     126}, {0xffffffc,             28,     127},
-    {0xfffe6,               20,     128}, {0x3fffd2,              22,     129}, {0xfffe7,               20,     130}, {0xfffe8,               20,     131},
-    {0x3fffd3,              22,     132}, {0x3fffd4,              22,     133}, {0x3fffd5,              22,     134}, {0x7fffd9,              23,     135},
-    {0x3fffd6,              22,     136}, {0x7fffda,              23,     137}, {0x7fffdb,              23,     138}, {0x7fffdc,              23,     139},
-    {0x7fffdd,              23,     140}, {0x7fffde,              23,     141}, {0xffffeb,              24,     142}, {0x7fffdf,              23,     143},
-    {0xffffec,              24,     144}, {0xffffed,              24,     145}, {0x3fffd7,              22,     146}, {0x7fffe0,              23,     147},
-    {0xffffee,              24,     148}, {0x7fffe1,              23,     149}, {0x7fffe2,              23,     150}, {0x7fffe3,              23,     151},
-    {0x7fffe4,              23,     152}, {0x1fffdc,              21,     153}, {0x3fffd8,              22,     154}, {0x7fffe5,              23,     155},
-    {0x3fffd9,              22,     156}, {0x7fffe6,              23,     157}, {0x7fffe7,              23,     158}, {0xffffef,              24,     159},
-    {0x3fffda,              22,     160}, {0x1fffdd,              21,     161}, {0xfffe9,               20,     162}, {0x3fffdb,              22,     163},
-    {0x3fffdc,              22,     164}, {0x7fffe8,              23,     165}, {0x7fffe9,              23,     166}, {0x1fffde,              21,     167},
-    {0x7fffea,              23,     168}, {0x3fffdd,              22,     169}, {0x3fffde,              22,     170}, {0xfffff0,              24,     171},
-    {0x1fffdf,              21,     172}, {0x3fffdf,              22,     173}, {0x7fffeb,              23,     174}, {0x7fffec,              23,     175},
-    {0x1fffe0,              21,     176}, {0x1fffe1,              21,     177}, {0x3fffe0,              22,     178}, {0x1fffe2,              21,     179},
-    {0x7fffed,              23,     180}, {0x3fffe1,              22,     181}, {0x7fffee,              23,     182}, {0x7fffef,              23,     183},
-    {0xfffea,               20,     184}, {0x3fffe2,              22,     185}, {0x3fffe3,              22,     186}, {0x3fffe4,              22,     187},
-    {0x7ffff0,              23,     188}, {0x3fffe5,              22,     189}, {0x3fffe6,              22,     190}, {0x7ffff1,              23,     191},
-    {0x3ffffe0,             26,     192}, {0x3ffffe1,             26,     193}, {0xfffeb,               20,     194}, {0x7fff1,               19,     195},
-    {0x3fffe7,              22,     196}, {0x7ffff2,              23,     197}, {0x3fffe8,              22,     198}, {0x1ffffec,             25,     199},
-    {0x3ffffe2,             26,     200}, {0x3ffffe3,             26,     201}, {0x3ffffe4,             26,     202}, {0x7ffffde,             27,     203},
-    {0x7ffffdf,             27,     204}, {0x3ffffe5,             26,     205}, {0xfffff1,              24,     206}, {0x1ffffed,             25,     207},
-    {0x7fff2,               19,     208}, {0x1fffe3,              21,     209}, {0x3ffffe6,             26,     210}, {0x7ffffe0,             27,     211},
-    {0x7ffffe1,             27,     212}, {0x3ffffe7,             26,     213}, {0x7ffffe2,             27,     214}, {0xfffff2,              24,     215},
-    {0x1fffe4,              21,     216}, {0x1fffe5,              21,     217}, {0x3ffffe8,             26,     218}, {0x3ffffe9,             26,     219},
-    {0xffffffd,             28,     220}, {0x7ffffe3,             27,     221}, {0x7ffffe4,             27,     222}, {0x7ffffe5,             27,     223},
-    {0xfffec,               20,     224}, {0xfffff3,              24,     225}, {0xfffed,               20,     226}, {0x1fffe6,              21,     227},
-    {0x3fffe9,              22,     228}, {0x1fffe7,              21,     229}, {0x1fffe8,              21,     230}, {0x7ffff3,              23,     231},
-    {0x3fffea,              22,     232}, {0x3fffeb,              22,     233}, {0x1ffffee,             25,     234}, {0x1ffffef,             25,     235},
-    {0xfffff4,              24,     236}, {0xfffff5,              24,     237}, {0x3ffffea,             26,     238}, {0x7ffff4,              23,     239},
-    {0x3ffffeb,             26,     240}, {0x7ffffe6,             27,     241}, {0x3ffffec,             26,     242}, {0x3ffffed,             26,     243},
-    {0x7ffffe7,             27,     244}, {0x7ffffe8,             27,     245}, {0x7ffffe9,             27,     246}, {0x7ffffea,             27,     247},
-    {0x7ffffeb,             27,     248}, {0xffffffe,             28,     249}, {0x7ffffec,             27,     250}, {0x7ffffed,             27,     251},
-    {0x7ffffee,             27,     252}, {0x7ffffef,             27,     253}, {0x7fffff0,             27,     254}, {0x3ffffee,             26,     255},
-    {0x3fffffff,            30,     256}
 };
- 
 
-static int HPACK_LEN  = sizeof(struct _hpack_table);
+#define HPACK_LEN   ((int)sizeof(struct _hpack_table))
 
-static int HPACK_SIZE  = sizeof(hpack_table) / HPACK_LEN;
+#define HPACK_SIZE  257
 
-static int HPACK_BYTES = HPACK_SIZE * HPACK_LEN;
+#define HPACK_BYTES (HPACK_SIZE * HPACK_LEN)
 
-static struct _hpack_table *phpack_table_deocde_sorted = 0;    
-    
-inline int sort_hpack_by_freq( const void *a, const void *b);
+#define HPACK_EOS 256                   /* Symbol index of the EOS code (30 bits, all ones) */
+
+/*
+ * The HPACK code, indexed by symbol.  Defined once, read-only, in huffman.c.
+ */
+extern const struct _hpack_table hpack_table[HPACK_SIZE];
 
 void huffman_zero_mem( void *ptr, size_t length );
 
@@ -114,22 +58,16 @@ void huffman_zero_mem( void *ptr, size_t length );
 /***** Library functions *******/
 
 /*
- * This function builds and sorts the internal tables needed to
- * decode Huffman-encoded strings.  If the library is NOT initialized
- * before a call to decompress(), this function will be called resulting
- * in an extra function call at the time of decoding; it's a good idea
- * to call this function ahead of time in preparation for using the library.
+ * Kept for compatibility.  The tables needed to decode Huffman-encoded
+ * strings are generated at build time and live in read-only data, so
+ * there is nothing left to initialize and calling this is optional.
  * 
  * Params:              - NONE
  * 
  * 
  * Returns: 
  * 
- *  HUFFMAN_SUCCESS     - The library was initialized successfully
- * 
- *  HUFFMAN_NO_MEMORY   - The system could not allocate enough memory
- * 
- *  HUFFMAN_INIT_ERROR  - An unspecified error occured.
+ *  HUFFMAN_SUCCESS     - Always.
  * 
  */
 int prep_hpack_compression( void );
@@ -154,10 +92,18 @@ int prep_hpack_compression( void );
  *               This parameter MAY be NULL.  In this case, decompress() will
  *               allocate the buffer (possible tiny performance hit).
  * 
+ *               A buffer that is too small is reallocated to the exact size
+ *               of the decoded string plus its terminator.  Use
+ *               huffman_decode() to learn that size or to decode into
+ *               memory that must not be reallocated.
+ * 
  *               It is the responsibility of the application to free this 
  *               buffer whether or not it is changed within decompress().
  * 
- *               If the function fails, the output buffer will be untouched.
+ *               If the function fails, a buffer passed in is still in
+ *               *output and still the application's to free, but
+ *               decompress() may already have written to it, so its
+ *               contents are undefined.
  * 
  *      outlen - The initial size of the buffer referenced by the output
  *               parameter.  This will be used to determine if decompress()
@@ -168,11 +114,13 @@ int prep_hpack_compression( void );
  *      A Positive integer representing the size of the returned string in
  *      bytes.
  * 
- *      HUFFMAN_INIT_ERROR      - An internal call to prep_hpack_compression() failed.
- * 
  *      HUFFMAN_NO_MEMORY       - decompress() could not allocate additional memory
  *                                to complete the decoding.
  * 
+ *      HUFFMAN_BAD_PARAMETER   - 'output' points to NULL and the buffer
+ *                                decompress() would allocate for 'inlen'
+ *                                octets does not fit in an int.
+ * 
  *      HUFFMAN_INTERNAL_ERROR  - An unspecified error occured.
  * 
  * 
@@ -208,6 +156,795 @@ uint8_t *compress(const uint8_t *input, int inlen, int *outlen);
 
 
 
+/*
+ * huffman_encode() - Huffman-encodes a string into a caller-provided buffer
+ * 
+ * PARAMETERS:
+ * 
+ *      input           - A pointer to the buffer to compress.
+ * 
+ *      inlen           - The size in bytes of the buffer to compress.
+ * 
+ *      output          - The buffer to receive the encoded octets.  This
+ *                        parameter MAY be NULL to only query the size.
+ * 
+ *      outcap          - The size in octets of 'output'.
+ * 
+ * RETURNS:
+ * 
+ *      The number of octets the encoded string takes.  When this is
+ *      larger than 'outcap' (or 'output' is NULL), nothing was written;
+ *      call again with a buffer at least that large.
+ * 
+ *      HUFFMAN_BAD_PARAMETER   - A negative length or a NULL input with a
+ *                                non-zero length.
+ * 
+ */
+int huffman_encode(const uint8_t *input, int inlen, uint8_t *output, int outcap);
+
+
+/*
+ * huffman_encoded_length() - Size of the Huffman encoding of a string,
+ *                            without encoding it.
+ *
+ * PARAMETERS:
+ *
+ *      input           - A pointer to the buffer to measure.
+ *
+ *      inlen           - The size in bytes of the buffer to measure.
+ *
+ *      limit           - The largest size of interest, or -1 for no limit.
+ *                        Counting stops as soon as the size is known to
+ *                        be over it.
+ *
+ * RETURNS:
+ *
+ *      The number of octets huffman_encode() would write, or 'limit' + 1
+ *      when that is more than 'limit'.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A negative length, a NULL input with a
+ *                                non-zero length or a size that does not
+ *                                fit in an int.
+ *
+ */
+int huffman_encoded_length(const uint8_t *input, int inlen, int limit);
+
+
+/*
+ * huffman_encode_if_shorter() - Writes a string literal the way an HPACK
+ *                               encoder should: Huffman-encoded when that
+ *                               is shorter, as is otherwise.  Strings that
+ *                               do not shrink are only measured until
+ *                               they reach their own length, then copied.
+ *
+ * PARAMETERS:
+ *
+ *      input           - A pointer to the string.
+ *
+ *      inlen           - The size in bytes of the string.
+ *
+ *      output          - The buffer to receive the literal.  This
+ *                        parameter MAY be NULL to only query the size.
+ *
+ *      outcap          - The size in octets of 'output'.
+ *
+ *      huffman         - Receives 1 when the literal is Huffman-encoded
+ *                        (the HPACK 'H' bit) and ZERO when it is raw.
+ *
+ * RETURNS:
+ *
+ *      The number of octets the literal takes.  When this is larger than
+ *      'outcap' (or 'output' is NULL), nothing was written; call again
+ *      with a buffer at least that large.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A negative length, a NULL input with a
+ *                                non-zero length or no 'huffman'.
+ *
+ */
+int huffman_encode_if_shorter(const uint8_t *input, int inlen, uint8_t *output, int outcap, int *huffman);
+
+
+/*
+ * huffman_decode() - Decodes a Huffman-encoded string into a caller-provided
+ *                    buffer.  Nothing is allocated and no terminator is
+ *                    written.
+ * 
+ * PARAMETERS:
+ * 
+ *      input           - A pointer to the buffer to decompress.
+ * 
+ *      inlen           - The size in octets of the buffer to decompress.
+ * 
+ *      output          - The buffer to receive the decoded string.  This
+ *                        parameter MAY be NULL to only query the size.
+ * 
+ *      outcap          - The size in octets of 'output'.
+ * 
+ * RETURNS:
+ * 
+ *      The length of the decoded string.  When this is larger than
+ *      'outcap' (or 'output' is NULL), only the first 'outcap' octets
+ *      were stored; call again with a buffer at least that large.
+ * 
+ *      HUFFMAN_BAD_PARAMETER   - A negative length or a NULL input with a
+ *                                non-zero length.
+ * 
+ */
+int huffman_decode(const uint8_t *input, int inlen, char *output, int outcap);
+
+
+
+/*
+ * One input string for the batch calls.
+ */
+struct huffman_string {
+    const uint8_t *data;
+    int len;
+};
+
+
+/*
+ * huffman_decode_batch() - Decodes many Huffman-encoded strings (e.g. all
+ *                          the literals of a header block) in one call.
+ *                          Independent strings are decoded side by side
+ *                          to overlap their table lookups.
+ * 
+ * PARAMETERS:
+ * 
+ *      inputs          - An array of 'count' encoded strings.
+ * 
+ *      count           - The number of strings.
+ * 
+ *      output          - One buffer to receive all decoded strings back
+ *                        to back, without terminators.  This parameter
+ *                        MAY be NULL to only query the size.
+ * 
+ *      outcap          - The size in octets of 'output'.
+ * 
+ *      offsets         - An array of 'count' + 1 integers.  String 'i'
+ *                        is decoded to output[offsets[i]] through
+ *                        output[offsets[i+1] - 1].
+ * 
+ * RETURNS:
+ * 
+ *      The total length of the decoded strings.  When this is larger than
+ *      'outcap' (or 'output' is NULL), only part of the output was
+ *      stored; call again with a buffer at least that large.
+ * 
+ *      HUFFMAN_BAD_PARAMETER   - A negative length, a NULL pointer with a
+ *                                non-zero length, no 'offsets' or a total
+ *                                that does not fit in an int.
+ * 
+ */
+int huffman_decode_batch(const struct huffman_string *inputs, int count, char *output, int outcap, int *offsets);
+
+
+/*
+ * huffman_encode_batch() - Huffman-encodes many strings in one call.
+ *                          Independent strings are encoded side by side.
+ * 
+ * PARAMETERS:
+ * 
+ *      inputs          - An array of 'count' strings to encode.
+ * 
+ *      count           - The number of strings.
+ * 
+ *      output          - One buffer to receive all encoded strings back to
+ *                        back.  This parameter MAY be NULL to only query
+ *                        the size.
+ * 
+ *      outcap          - The size in octets of 'output'.
+ * 
+ *      offsets         - An array of 'count' + 1 integers.  String 'i'
+ *                        is encoded to output[offsets[i]] through
+ *                        output[offsets[i+1] - 1].  It is filled in even
+ *                        when nothing is written.
+ * 
+ * RETURNS:
+ * 
+ *      The total size of the encoded strings.  When this is larger than
+ *      'outcap' (or 'output' is NULL), nothing was written.
+ * 
+ *      HUFFMAN_BAD_PARAMETER   - A negative length, a NULL pointer with a
+ *                                non-zero length, no 'offsets' or a total
+ *                                that does not fit in an int.
+ * 
+ */
+int huffman_encode_batch(const struct huffman_string *inputs, int count, uint8_t *output, int outcap, int *offsets);
+
+
+/*
+ * Streaming decoder.  Holds the bits of a symbol that is split across
+ * input fragments so a string can be decoded straight out of the
+ * buffers it arrived in (HEADERS/CONTINUATION frames, TLS records).
+ * Treat the members as private.
+ */
+struct huffman_decoder {
+    uint64_t acc;                       /* Pending bits, most significant first */
+    int avail;                          /* Number of pending bits (never more than 29) */
+    int error;                          /* Sticky error code, or ZERO */
+};
+
+/*
+ * Largest number of octets huffman_decoder_feed() can produce from 'inlen'
+ * octets of input, counting the bits still pending from earlier fragments.
+ * It is an int64_t: for fragments over 268 MB it does not fit in an int.
+ */
+#define HUFFMAN_DECODER_BOUND(inlen) ((((int64_t)(inlen) * 8) + 29) / 5)
+
+
+/*
+ * huffman_decoder_init() - Prepares a streaming decoder for a new string.
+ * 
+ * PARAMETERS:
+ * 
+ *      d               - The decoder to (re)initialize.
+ * 
+ * RETURNS:
+ * 
+ *      HUFFMAN_SUCCESS         - The decoder is ready.
+ * 
+ */
+int huffman_decoder_init(struct huffman_decoder *d);
+
+
+/*
+ * huffman_decoder_feed() - Decodes the next fragment of a Huffman-encoded
+ *                          string.
+ * 
+ * PARAMETERS:
+ * 
+ *      d               - A decoder set up with huffman_decoder_init().
+ * 
+ *      input           - The next fragment of the encoded string.  It does
+ *                        not need to end on a symbol boundary.
+ * 
+ *      inlen           - The size in octets of the fragment.
+ * 
+ *      output          - The buffer to receive the decoded octets.
+ * 
+ *      outcap          - The size in octets of 'output'.  It must be at
+ *                        least HUFFMAN_DECODER_BOUND(inlen).
+ * 
+ * RETURNS:
+ * 
+ *      The number of decoded octets written to 'output' (possibly ZERO).
+ * 
+ *      HUFFMAN_EOS_DECODED     - The string contains the EOS symbol.  The
+ *                                decoder stays in this state.
+ * 
+ *      HUFFMAN_BAD_PARAMETER   - Bad arguments or 'outcap' below the bound.
+ * 
+ */
+int huffman_decoder_feed(struct huffman_decoder *d, const uint8_t *input, int inlen, char *output, int outcap);
+
+
+/*
+ * huffman_decoder_finish() - Ends the string and validates its padding.
+ * 
+ * PARAMETERS:
+ * 
+ *      d               - The decoder that was fed the whole string.
+ * 
+ * RETURNS:
+ * 
+ *      HUFFMAN_SUCCESS         - The string ended on a symbol or on at most
+ *                                7 bits of EOS padding.
+ * 
+ *      HUFFMAN_PADDING_TOO_LONG - More than 7 bits of padding.
+ * 
+ *      HUFFMAN_PADDING_INVALID - The leftover bits are not all ones, i.e.
+ *                                the string was cut inside a symbol.
+ * 
+ *      HUFFMAN_EOS_DECODED     - An earlier fragment contained EOS.
+ * 
+ */
+int huffman_decoder_finish(struct huffman_decoder *d);
+
+
+
+/*
+ * Checked decoding for untrusted header blocks.  huffman_decode_checked()
+ * applies the RFC 7541 rules for the end of a string, checks the decoded
+ * octets as a field name or value (RFC 9113, section 8.2.1) and hashes
+ * them, all while decoding, so the string is only read once.
+ */
+#define HUFFMAN_VALIDATE_NAME 1         /* No uppercase, controls, SP, DEL or non-ASCII; ':' only first */
+#define HUFFMAN_VALIDATE_VALUE 2        /* No NUL, LF or CR; no SP or HTAB first or last */
+
+#define HUFFMAN_HASH_NONE 0
+#define HUFFMAN_HASH_FNV1A_32 1
+#define HUFFMAN_HASH_FNV1A_64 2
+#define HUFFMAN_HASH_CRC32C 3
+
+struct huffman_check {
+    int validate;                       /* HUFFMAN_VALIDATE_xxx, or ZERO to only check the coding */
+    int hash;                           /* HUFFMAN_HASH_xxx */
+    uint64_t seed;                      /* XORed into the hash's initial value; ZERO for the standard hash */
+    uint64_t hash_value;                /* Receives the hash of the decoded string */
+    int error_offset;                   /* Receives where the string went wrong, or -1 */
+};
+
+
+/*
+ * huffman_decode_checked() - huffman_decode() for untrusted input.
+ *
+ * PARAMETERS:
+ *
+ *      input, inlen, output, outcap - As for huffman_decode().  Checks
+ *                        and hash cover the whole string even when it is
+ *                        not stored, so a NULL 'output' validates and
+ *                        hashes without decoding anywhere.
+ *
+ *      check           - Says what to check and which hash to compute,
+ *                        and receives the hash and the error offset.
+ *
+ * RETURNS:
+ *
+ *      The decoded length; 'check->hash_value' holds the hash.
+ *
+ *      HUFFMAN_EOS_DECODED     - The string holds an EOS symbol.
+ *
+ *      HUFFMAN_PADDING_TOO_LONG - The string ends with more than 7 bits
+ *                                of padding.
+ *
+ *      HUFFMAN_PADDING_INVALID - The padding is not all ones.
+ *
+ *      HUFFMAN_NAME_UPPERCASE,
+ *      HUFFMAN_NAME_INVALID,
+ *      HUFFMAN_VALUE_INVALID   - The decoded string is not a valid field
+ *                                name or value.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A NULL 'check', an unknown 'validate' or
+ *                                'hash', a negative length or a NULL
+ *                                input with a non-zero length.
+ *
+ *      On an error 'check->error_offset' is the offset in the decoded
+ *      string of the first bad octet, or where the bad ending starts;
+ *      'check->hash_value' is ZERO.  Coding errors are reported before
+ *      octet errors.
+ *
+ */
+int huffman_decode_checked(const uint8_t *input, int inlen, char *output, int outcap, struct huffman_check *check);
+
+
+
+/*
+ * Cache of coded strings for values that repeat (user agents, cookies,
+ * content types).  It lives in one fixed block and is split into shards
+ * with their own locks, so worker threads can share one cache.  Once the
+ * block is full, new entries replace the oldest.
+ */
+struct huffman_cache;
+
+#define HUFFMAN_CACHE_MIN_SIZE 65536    /* Smallest size huffman_cache_create() accepts */
+
+struct huffman_cache_stats {
+    uint64_t hits;                      /* hits / (hits + misses) is the hit ratio */
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t bytes;                     /* Memory held by the cache */
+};
+
+
+/*
+ * huffman_cache_create() - Allocates a cache.  This is the only
+ *                          allocation it ever makes.
+ *
+ * PARAMETERS:
+ *
+ *      size            - Most memory in octets the cache may use, at least
+ *                        HUFFMAN_CACHE_MIN_SIZE.  About three quarters of
+ *                        it holds cached strings.
+ *
+ * RETURNS:
+ *
+ *      A cache to pass to the calls below and free with
+ *      huffman_cache_destroy(), or NULL when 'size' is too small or the
+ *      memory could not be allocated.
+ *
+ */
+struct huffman_cache *huffman_cache_create(size_t size);
+
+
+/*
+ * huffman_cache_destroy() - Frees a cache.  No other thread may be using it.
+ */
+void huffman_cache_destroy(struct huffman_cache *cache);
+
+
+/*
+ * huffman_cache_encode() / huffman_cache_decode() - huffman_encode() and
+ * huffman_decode() through a cache.  A hit copies the stored result
+ * instead of running the coder; a miss codes the string and stores the
+ * result when it was written out in full.  A string whose input and
+ * result together take more than about 1% of the cache is coded but
+ * not stored.
+ *
+ * PARAMETERS:
+ *
+ *      cache           - The cache to use.  This parameter MAY be NULL, in
+ *                        which case the call is the plain one.
+ *
+ *      input, inlen, output, outcap - As for huffman_encode() /
+ *                        huffman_decode().
+ *
+ * RETURNS:
+ *
+ *      As huffman_encode() / huffman_decode().
+ *
+ */
+int huffman_cache_encode(struct huffman_cache *cache, const uint8_t *input, int inlen, uint8_t *output, int outcap);
+int huffman_cache_decode(struct huffman_cache *cache, const uint8_t *input, int inlen, char *output, int outcap);
+
+
+/*
+ * huffman_cache_get_stats() - Reads a cache's counters.
+ *
+ * RETURNS:
+ *
+ *      HUFFMAN_SUCCESS         - 'stats' is filled in.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - 'cache' or 'stats' is NULL.
+ *
+ */
+int huffman_cache_get_stats(struct huffman_cache *cache, struct huffman_cache_stats *stats);
+
+
+
+/*
+ * Counters kept when the library is built with HUFFMAN_STATS (see
+ * huffman_get_stats()).  Every thread counts into its own block; the
+ * blocks are only summed when the counters are read.
+ */
+#define HUFFMAN_STATS_MAX_BITS 30       /* Longest code (EOS) */
+#define HUFFMAN_STATS_ERRORS (1 - HUFFMAN_LOWEST_ERROR)  /* errors[] is indexed by -HUFFMAN_xxx */
+
+struct huffman_stats {
+    uint64_t encode_calls;              /* Strings encoded */
+    uint64_t encode_bytes_in;
+    uint64_t encode_bytes_out;          /* encode_bytes_out / encode_bytes_in is the compression ratio */
+    uint64_t decode_calls;              /* Strings decoded */
+    uint64_t decode_bytes_in;
+    uint64_t decode_bytes_out;
+    uint64_t allocations;               /* Buffers allocated by compress() / decompress() */
+    uint64_t reallocations;             /* decompress() buffers that had to grow */
+    uint64_t code_lengths[HUFFMAN_STATS_MAX_BITS + 1];  /* Symbols coded, by code length in bits */
+    uint64_t errors[HUFFMAN_STATS_ERRORS];              /* Failures, e.g. errors[-HUFFMAN_PADDING_INVALID] */
+    uint64_t encode_cycles;             /* Only with HUFFMAN_STATS_CYCLES: time spent */
+    uint64_t decode_cycles;             /* encoding and decoding, in CPU cycles */
+};
+
+
+/*
+ * huffman_get_stats() - Reads the counters of all threads.
+ *
+ * PARAMETERS:
+ *
+ *      stats           - Receives the totals since the start of the
+ *                        process or the last huffman_reset_stats().
+ *
+ * RETURNS:
+ *
+ *      HUFFMAN_SUCCESS         - 'stats' is filled in.
+ *
+ *      HUFFMAN_NO_ERROR        - The library was built without
+ *                                HUFFMAN_STATS; 'stats' is all zeros.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - 'stats' is NULL.
+ *
+ */
+int huffman_get_stats(struct huffman_stats *stats);
+
+
+/*
+ * huffman_reset_stats() - Starts counting again from zero.  Counts made
+ * by other threads while this runs land on either side of the reset.
+ */
+void huffman_reset_stats(void);
+
+
+
+/*
+ * Trained codebooks.  The HPACK code is tuned for HTTP headers; strings
+ * from elsewhere (log lines, JSON keys, binary IDs) compress better with
+ * a code built from samples of their own.  A codebook is a canonical
+ * Huffman code over the 256 octets and an EOS symbol, limited to
+ * 'max_bits' bits per code and coded by the same kernels as the HPACK
+ * code.  EOS always gets the longest code, which is all ones, so the
+ * padding rules are those of RFC 7541 section 5.2.  Codebooks are
+ * read-only once built and may be shared between threads.
+ */
+struct huffman_codebook;
+
+#define HUFFMAN_CODEBOOK_MIN_BITS 9     /* 257 symbols need at least 9-bit codes */
+#define HUFFMAN_CODEBOOK_MAX_BITS 30    /* The decoder's limit, as for EOS in the HPACK code */
+#define HUFFMAN_CODEBOOK_SIZE 162       /* Serialized size: a version octet and 257 5-bit lengths */
+
+
+/*
+ * huffman_codebook_build() - Builds the code that best compresses octets
+ *                            with the given frequencies.
+ *
+ * PARAMETERS:
+ *
+ *      histogram       - How often each octet occurs.  Octets that never
+ *                        occur still get a (long) code.
+ *
+ *      max_bits        - The longest code allowed, from
+ *                        HUFFMAN_CODEBOOK_MIN_BITS to
+ *                        HUFFMAN_CODEBOOK_MAX_BITS.  Lower limits cost a
+ *                        little ratio but bound the worst case: no octet
+ *                        ever takes more than 'max_bits' bits.
+ *
+ * RETURNS:
+ *
+ *      A codebook to free with huffman_codebook_destroy(), or NULL when
+ *      'max_bits' is out of range or the memory could not be allocated.
+ *
+ */
+struct huffman_codebook *huffman_codebook_build(const uint64_t histogram[256], int max_bits);
+
+
+/*
+ * huffman_codebook_train() - huffman_codebook_build() with the histogram
+ *                            of a set of sample strings.
+ *
+ * PARAMETERS:
+ *
+ *      samples         - The strings, as for huffman_encode_batch().
+ *
+ *      count           - The number of strings.
+ *
+ *      max_bits        - As for huffman_codebook_build().
+ *
+ * RETURNS:
+ *
+ *      As huffman_codebook_build(); also NULL when 'samples' is NULL or
+ *      a string has a negative length.
+ *
+ */
+struct huffman_codebook *huffman_codebook_train(const struct huffman_string *samples, int count, int max_bits);
+
+
+/*
+ * huffman_codebook_serialize() - Writes a codebook out in
+ *                                HUFFMAN_CODEBOOK_SIZE octets.  Only the
+ *                                code lengths are stored; the codes follow
+ *                                from them.
+ *
+ * RETURNS:
+ *
+ *      HUFFMAN_CODEBOOK_SIZE.  Nothing is written when 'output' is NULL
+ *      or 'outcap' is too small.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - 'cb' is NULL.
+ *
+ */
+int huffman_codebook_serialize(const struct huffman_codebook *cb, uint8_t *output, int outcap);
+
+
+/*
+ * huffman_codebook_load() - Rebuilds a codebook from
+ *                           huffman_codebook_serialize() output.
+ *
+ * RETURNS:
+ *
+ *      The codebook, identical to the one serialized, or NULL when the
+ *      input is not a valid serialized codebook or the memory could not
+ *      be allocated.
+ *
+ */
+struct huffman_codebook *huffman_codebook_load(const uint8_t *input, int inlen);
+
+
+/*
+ * huffman_codebook_destroy() - Frees a codebook.
+ */
+void huffman_codebook_destroy(struct huffman_codebook *cb);
+
+
+/*
+ * huffman_codebook_encode() / huffman_codebook_decode() - huffman_encode()
+ * and huffman_decode() with a trained code instead of the HPACK code.
+ *
+ * PARAMETERS:
+ *
+ *      cb              - The codebook.  Strings must be decoded with the
+ *                        codebook that encoded them.
+ *
+ *      input, inlen, output, outcap - As for huffman_encode() /
+ *                        huffman_decode().  A trained code may have codes
+ *                        as short as one bit, so a string can decode to
+ *                        up to 8 times its encoded size.
+ *
+ * RETURNS:
+ *
+ *      As huffman_encode() / huffman_decode(); HUFFMAN_BAD_PARAMETER also
+ *      when 'cb' is NULL.
+ *
+ */
+int huffman_codebook_encode(const struct huffman_codebook *cb, const uint8_t *input, int inlen, uint8_t *output, int outcap);
+int huffman_codebook_decode(const struct huffman_codebook *cb, const uint8_t *input, int inlen, char *output, int outcap);
+
+
+
+/*
+ * Framed mode for large inputs.  compress() codes one bit stream, so one
+ * buffer keeps one core busy however large it is.  A frame cuts the input
+ * into blocks of a fixed size that are coded independently, behind an
+ * index of each block's position and length: blocks are coded in
+ * parallel on a thread pool, and any block can be decoded without the
+ * others.
+ */
+struct huffman_pool;
+
+#define HUFFMAN_FRAME_HEADER 12                 /* Octets before the index */
+#define HUFFMAN_FRAME_BLOCK_SIZE (64 * 1024)    /* A good block size for most inputs */
+
+struct huffman_frame_info {
+    int blocks;
+    int block_size;                     /* Original octets per block; the last may be shorter */
+    int length;                         /* Original octets in all */
+    int frame_length;                   /* Octets the frame itself takes */
+};
+
+
+/*
+ * huffman_pool_create() - Starts a pool of worker threads for the frame
+ *                         calls.  Idle workers sleep.  Each worker has its
+ *                         own range of blocks and steals half of another's
+ *                         when it runs out, so uneven blocks balance out.
+ *
+ * PARAMETERS:
+ *
+ *      threads         - Worker threads to start.  The thread making a
+ *                        call works too, so 'threads' + 1 blocks are coded
+ *                        at a time.  A negative value starts one fewer
+ *                        than the number of online CPUs.
+ *
+ * RETURNS:
+ *
+ *      The pool, or NULL when the memory could not be allocated.  A pool
+ *      may end up with fewer threads than asked for when the system
+ *      refuses to start more; it still works.
+ *
+ */
+struct huffman_pool *huffman_pool_create(int threads);
+
+
+/*
+ * huffman_pool_destroy() - Stops the workers and frees a pool.  No call
+ * may be using it.
+ */
+void huffman_pool_destroy(struct huffman_pool *pool);
+
+
+/*
+ * huffman_frame_encode() - Codes 'input' as a frame.
+ *
+ * PARAMETERS:
+ *
+ *      pool            - The pool to code the blocks on.  This parameter
+ *                        MAY be NULL, in which case the calling thread
+ *                        codes every block.  A pool takes one call at a
+ *                        time; calls from other threads wait their turn.
+ *
+ *      cb              - The codebook to code with, or NULL for the HPACK
+ *                        code.  The frame does not record which one was
+ *                        used; decode with the same.
+ *
+ *      input           - The data to code.
+ *
+ *      inlen           - The size in octets of 'input'.
+ *
+ *      block_size      - Original octets per block, e.g.
+ *                        HUFFMAN_FRAME_BLOCK_SIZE.  Smaller blocks give
+ *                        finer random access and more parallelism, at 8
+ *                        octets of index and up to 1 octet of padding
+ *                        each.
+ *
+ *      output          - The buffer to receive the frame.  This parameter
+ *                        MAY be NULL.
+ *
+ *      outcap          - The size in octets of 'output'.
+ *
+ * RETURNS:
+ *
+ *      The size in octets of the frame.  It is only written when 'output'
+ *      is large enough; otherwise the size is all that is computed.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A NULL input with a length, a negative
+ *                                length or capacity, a 'block_size' under
+ *                                1, or a frame larger than INT32_MAX.
+ *
+ *      HUFFMAN_NO_MEMORY       - The block table could not be allocated.
+ *
+ */
+int huffman_frame_encode(struct huffman_pool *pool, const struct huffman_codebook *cb, const uint8_t *input, int inlen, int block_size, uint8_t *output, int outcap);
+
+
+/*
+ * huffman_frame_info() - Reads a frame's header and the last entry of its
+ *                        index.
+ *
+ * RETURNS:
+ *
+ *      HUFFMAN_SUCCESS         - 'info' is filled in.
+ *
+ *      HUFFMAN_FRAME_INVALID   - 'input' does not start with a frame, or
+ *                                the frame is cut short.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - 'info' is NULL.
+ *
+ */
+int huffman_frame_info(const uint8_t *input, int inlen, struct huffman_frame_info *info);
+
+
+/*
+ * huffman_frame_decode() - Decodes a whole frame, its blocks in parallel.
+ *
+ * PARAMETERS:
+ *
+ *      pool, cb        - As for huffman_frame_encode().
+ *
+ *      input           - The frame.
+ *
+ *      inlen           - The size in octets of 'input'.  It may run past
+ *                        the end of the frame.
+ *
+ *      output          - The buffer to receive the original data.  This
+ *                        parameter MAY be NULL.
+ *
+ *      outcap          - The size in octets of 'output'.
+ *
+ * RETURNS:
+ *
+ *      The original length.  The data is only decoded when 'output' is
+ *      large enough.
+ *
+ *      HUFFMAN_FRAME_INVALID   - The frame is malformed, or a block does
+ *                                not decode to its indexed length.  The
+ *                                output is then incomplete.
+ *
+ *      HUFFMAN_BAD_PARAMETER   - A negative capacity.
+ *
+ */
+int huffman_frame_decode(struct huffman_pool *pool, const struct huffman_codebook *cb, const uint8_t *input, int inlen, char *output, int outcap);
+
+
+/*
+ * huffman_frame_decode_block() - Decodes one block on the calling thread
+ *                                without touching the others.  Block 'n'
+ *                                holds original octets from
+ *                                n * block_size on.
+ *
+ * PARAMETERS:
+ *
+ *      cb, input, inlen - As for huffman_frame_decode().
+ *
+ *      block           - The block, from 0 to blocks - 1.
+ *
+ *      output          - The buffer to receive the block.  This parameter
+ *                        MAY be NULL.
+ *
+ *      outcap          - The size in octets of 'output'; 'block_size' is
+ *                        always enough.
+ *
+ * RETURNS:
+ *
+ *      The block's original length.  It is only decoded when 'output' is
+ *      large enough.
+ *
+ *      HUFFMAN_FRAME_INVALID   - As for huffman_frame_decode().
+ *
+ *      HUFFMAN_BAD_PARAMETER   - No such block, or a negative capacity.
+ *
+ */
+int huffman_frame_decode_block(const struct huffman_codebook *cb, const uint8_t *input, int inlen, int block, char *output, int outcap);
+
+
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,357 @@
+/*
+ * File:   huffman.hpp
+ *
+ * C++20 interface to the Huffman codec.  Inputs are std::string_view and
+ * std::span, lengths are std::size_t, and results either go where the
+ * caller says (a span or an output iterator) or come back in a move-only
+ * buffer that owns them.  Nothing is copied behind the caller's back.
+ *
+ * The encoder is also constexpr and reads the same hpack_table.inc as
+ * huffman.c, so a string known at compile time can be encoded by the
+ * compiler:
+ *
+ *      constexpr auto &json = huffman::literal<"application/json">;
+ *
+ *      using namespace huffman::literals;
+ *      send(":method"_huffman, "GET"_huffman);
+ *
+ * Each literal is a std::array<std::uint8_t, N> in read-only data.
+ */
+
+#ifndef HUFFMAN_HPP
+#define HUFFMAN_HPP
+
+#if __cplusplus < 202002L
+#error "huffman.hpp needs C++20"
+#endif
+
+#include <array>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "huffman.h"
+
+namespace huffman {
+
+namespace detail {
+
+/*
+ * The HPACK code, indexed by symbol, for constant evaluation.
+ * hpack_table[] in huffman.c is built from the same rows.
+ */
+inline constexpr struct _hpack_table codes[HPACK_SIZE] = {
+#include "hpack_table.inc"
+};
+
+static_assert(codes[0].charval == 0 && codes[HPACK_EOS].charval == HPACK_EOS &&
+              codes[HPACK_EOS].bits == 30, "hpack_table.inc rows out of order");
+
+/*
+ * The C functions take int lengths.
+ */
+constexpr bool fits_int(std::size_t n) noexcept
+{
+    return n <= static_cast<std::size_t>(INT_MAX);
+}
+
+inline int int_length(std::size_t n)
+{
+    if (!fits_int(n)) {
+        throw std::length_error("huffman: string longer than INT_MAX");
+    }
+    return static_cast<int>(n);
+}
+
+} /* namespace detail */
+
+
+
+/*
+ * A move-only array that owns the result of a call.
+ */
+template <class T>
+class buffer {
+public:
+    buffer() noexcept = default;
+
+    buffer(std::unique_ptr<T[]> data, std::size_t size) noexcept
+        : data_(std::move(data)), size_(size) {}
+
+    buffer(buffer &&other) noexcept
+        : data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)) {}
+
+    buffer &operator=(buffer &&other) noexcept
+    {
+        data_ = std::move(other.data_);
+        size_ = std::exchange(other.size_, 0);
+        return *this;
+    }
+
+    buffer(const buffer &) = delete;
+    buffer &operator=(const buffer &) = delete;
+
+    T *data() noexcept { return data_.get(); }
+    const T *data() const noexcept { return data_.get(); }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    T *begin() noexcept { return data_.get(); }
+    T *end() noexcept { return data_.get() + size_; }
+    const T *begin() const noexcept { return data_.get(); }
+    const T *end() const noexcept { return data_.get() + size_; }
+
+    std::span<const T> span() const noexcept { return {data_.get(), size_}; }
+    operator std::span<const T>() const noexcept { return span(); }
+
+    std::string_view view() const noexcept requires std::same_as<T, char>
+    {
+        return {data_.get(), size_};
+    }
+
+    /*
+     * Moves ownership of the memory to the returned unique_ptr and leaves
+     * this buffer empty.
+     */
+    std::unique_ptr<T[]> release() noexcept
+    {
+        size_ = 0;
+        return std::move(data_);
+    }
+
+private:
+    std::unique_ptr<T[]> data_;
+    std::size_t size_ = 0;
+};
+
+using encoded_buffer = buffer<std::uint8_t>;
+using decoded_buffer = buffer<char>;
+
+
+
+/*
+ * encoded_length() - Octets the Huffman encoding of 'in' takes.  Counted
+ *                    by huffman_encoded_length() at run time.
+ */
+constexpr std::size_t encoded_length(std::string_view in)
+{
+    std::uint64_t bits = 0;
+
+    if (!std::is_constant_evaluated() && detail::fits_int(in.size())) {
+        int len = huffman_encoded_length(reinterpret_cast<const std::uint8_t *>(in.data()),
+                                         static_cast<int>(in.size()), -1);
+
+        if (len >= 0) {
+            return static_cast<std::size_t>(len);
+        }
+    }
+    for (char c : in) {
+        bits += detail::codes[static_cast<unsigned char>(c)].bits;
+    }
+    return static_cast<std::size_t>((bits + 7) / 8);
+}
+
+
+/*
+ * max_decoded_length() - Most octets 'inlen' encoded octets can decode
+ *                        to (the shortest code is 5 bits).
+ */
+constexpr std::size_t max_decoded_length(std::size_t inlen) noexcept
+{
+    return inlen / 5 * 8 + (inlen % 5) * 8 / 5;
+}
+
+
+/*
+ * encode() - Huffman-encodes 'in' through the output iterator 'out', one
+ *            octet at a time.  Usable in constant expressions; at run
+ *            time the span overload below is faster.
+ *
+ * RETURNS:
+ *
+ *      'out' past the last octet written.
+ */
+template <class OutputIt>
+    requires std::output_iterator<OutputIt, std::uint8_t>
+constexpr OutputIt encode(std::string_view in, OutputIt out)
+{
+    std::uint64_t acc = 0;
+    unsigned int n = 0;
+
+    for (char c : in) {
+        const struct _hpack_table &code = detail::codes[static_cast<unsigned char>(c)];
+
+        acc = (acc << code.bits) | code.value;
+        n += code.bits;
+        while (n >= 8) {
+            n -= 8;
+            *out = static_cast<std::uint8_t>(acc >> n);
+            ++out;
+        }
+    }
+    if (n > 0) {
+        /* Pad with the most significant bits of EOS */
+        *out = static_cast<std::uint8_t>((acc << (8 - n)) | (0xffu >> n));
+        ++out;
+    }
+    return out;
+}
+
+
+/*
+ * encode() - huffman_encode() into 'out'.
+ *
+ * RETURNS:
+ *
+ *      As huffman_encode(): the encoded length, and nothing written when
+ *      that is more than out.size().  HUFFMAN_BAD_PARAMETER for lengths
+ *      over INT_MAX.
+ */
+inline int encode(std::string_view in, std::span<std::uint8_t> out) noexcept
+{
+    if (!detail::fits_int(in.size())) {
+        return HUFFMAN_BAD_PARAMETER;
+    }
+    return huffman_encode(reinterpret_cast<const std::uint8_t *>(in.data()),
+                          static_cast<int>(in.size()), out.data(),
+                          detail::fits_int(out.size()) ? static_cast<int>(out.size()) : INT_MAX);
+}
+
+
+/*
+ * encode() - Huffman-encodes 'in' into a buffer of exactly its encoded
+ *            length.  Throws std::length_error for strings over INT_MAX
+ *            octets and std::bad_alloc.
+ */
+inline encoded_buffer encode(std::string_view in)
+{
+    int inlen = detail::int_length(in.size());
+    std::size_t size = encoded_length(in);
+    auto data = std::make_unique_for_overwrite<std::uint8_t[]>(size);
+
+    huffman_encode(reinterpret_cast<const std::uint8_t *>(in.data()), inlen,
+                   data.get(), detail::int_length(size));
+    return encoded_buffer(std::move(data), size);
+}
+
+
+/*
+ * decode() - huffman_decode() into 'out'.
+ *
+ * RETURNS:
+ *
+ *      As huffman_decode(): the decoded length, of which only the first
+ *      out.size() octets were stored when it is larger.
+ *      HUFFMAN_BAD_PARAMETER for lengths over INT_MAX.
+ */
+inline int decode(std::span<const std::uint8_t> in, std::span<char> out) noexcept
+{
+    if (!detail::fits_int(in.size())) {
+        return HUFFMAN_BAD_PARAMETER;
+    }
+    return huffman_decode(in.data(), static_cast<int>(in.size()), out.data(),
+                          detail::fits_int(out.size()) ? static_cast<int>(out.size()) : INT_MAX);
+}
+
+
+/*
+ * decode() - Decodes 'in' in one pass into a buffer of
+ *            max_decoded_length(in.size()) octets.  Throws
+ *            std::length_error for inputs over INT_MAX octets and
+ *            std::bad_alloc.
+ */
+inline decoded_buffer decode(std::span<const std::uint8_t> in)
+{
+    int inlen = detail::int_length(in.size());
+    std::size_t cap = max_decoded_length(in.size());
+    auto data = std::make_unique_for_overwrite<char[]>(cap);
+    int len;
+
+    len = huffman_decode(in.data(), inlen, data.get(), detail::int_length(cap));
+    return decoded_buffer(std::move(data), static_cast<std::size_t>(len));
+}
+
+
+/*
+ * decode_checked() - huffman_decode_checked() into 'out'.
+ *
+ * RETURNS:
+ *
+ *      As huffman_decode_checked().  HUFFMAN_BAD_PARAMETER for lengths
+ *      over INT_MAX.
+ */
+inline int decode_checked(std::span<const std::uint8_t> in, std::span<char> out,
+                          struct huffman_check &check) noexcept
+{
+    if (!detail::fits_int(in.size())) {
+        return HUFFMAN_BAD_PARAMETER;
+    }
+    return huffman_decode_checked(in.data(), static_cast<int>(in.size()), out.data(),
+                                  detail::fits_int(out.size()) ? static_cast<int>(out.size()) : INT_MAX,
+                                  &check);
+}
+
+
+
+/*
+ * A string literal as a template argument.
+ */
+template <std::size_t N>
+struct fixed_string {
+    char text[N] = {};
+
+    consteval fixed_string(const char (&s)[N])
+    {
+        for (std::size_t i = 0; i < N; i++) {
+            text[i] = s[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept { return {text, N - 1}; }
+};
+
+namespace detail {
+
+template <fixed_string S>
+consteval auto encode_literal()
+{
+    std::array<std::uint8_t, encoded_length(S.view())> out{};
+
+    encode(S.view(), out.begin());
+    return out;
+}
+
+} /* namespace detail */
+
+
+/*
+ * The Huffman encoding of 'S', computed by the compiler.
+ */
+template <fixed_string S>
+inline constexpr auto literal = detail::encode_literal<S>();
+
+
+namespace literals {
+
+/*
+ * "GET"_huffman is huffman::literal<"GET">.
+ */
+template <fixed_string S>
+constexpr const auto &operator""_huffman() noexcept
+{
+    return literal<S>;
+}
+
+} /* namespace literals */
+
+} /* namespace huffman */
+
+#endif /* HUFFMAN_HPP */
@@ -0,0 +1,64 @@
+/*
+ * File:   huffman_build.c
+ *
+ * Builds the multi-level decode table for a canonical prefix code.  The
+ * HPACK table is built once, by tools/huffman_gen.c, and checked in;
+ * trained codebooks are built when they are created or loaded.
+ */
+
+#include "huffman_build.h"
+
+/*
+ * Lays out the table for every code that starts with 'prefix' ('plen' bits)
+ * using 'width' index bits, recursing into sub-tables for longer codes.
+ * With a NULL 'tbl' it only counts the entries that would be used.
+ */
+static void huffman_build_level( const struct _hpack_table *codes, struct _huffman_decode_entry *tbl, int *used, uint32_t prefix, int plen, int width ) {
+    int base = *used, i = 0, s = 0, len = plen + width, leaf = 0, longest = 0, sub = 0;
+    uint32_t pattern = 0, bits = 0;
+
+    *used += (1 << width);
+    for (i = 0; i < (1 << width); i++) {
+        pattern = (prefix << width) | (uint32_t)i;
+        leaf = -1;
+        longest = 0;
+        for (s = 0; s < HPACK_SIZE; s++) {
+            bits = codes[s].bits;
+            if ((int)bits <= len) {
+                if ((pattern >> (len - bits)) == codes[s].value) {
+                    leaf = s;
+                    break;
+                }
+            } else if ((codes[s].value >> (bits - len)) == pattern && (int)bits > longest) {
+                longest = (int)bits;
+            }
+        }
+        if (leaf >= 0) {
+            if (tbl) {
+                tbl[base+i].next = (uint16_t)codes[leaf].charval;
+                tbl[base+i].bits = (uint8_t)codes[leaf].bits;
+                tbl[base+i].flags = 0;
+            }
+        } else if (longest) {
+            sub = longest - len;
+            if (sub > HUFFMAN_DECODE_SUB_BITS) sub = HUFFMAN_DECODE_SUB_BITS;
+            if (tbl) {
+                tbl[base+i].next = (uint16_t)*used;
+                tbl[base+i].bits = (uint8_t)sub;
+                tbl[base+i].flags = HUFFMAN_DECODE_LINK;
+            }
+            huffman_build_level(codes, tbl, used, pattern, len, sub);
+        } else if (tbl) {
+            tbl[base+i].next = 0;
+            tbl[base+i].bits = HUFFMAN_DECODE_INVALID;
+            tbl[base+i].flags = 0;
+        }
+    }
+}
+
+int huffman_build_decode_table( const struct _hpack_table *codes, struct _huffman_decode_entry *tbl ) {
+    int used = 0;
+
+    huffman_build_level(codes, tbl, &used, 0, 0, HUFFMAN_DECODE_ROOT_BITS);
+    return used;
+}
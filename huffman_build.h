@@ -0,0 +1,49 @@
+/*
+ * File:   huffman_build.h
+ *
+ * Decode table layout shared by huffman.c, huffman_codebook.c and the
+ * table generator in tools/huffman_gen.c, so the checked-in HPACK table
+ * and the tables built for trained codebooks at run time come out of the
+ * same code.
+ */
+
+#ifndef HUFFMAN_BUILD_H
+#define HUFFMAN_BUILD_H
+
+#include "huffman.h"
+
+/*
+ * Multi-level decode table.  The top HUFFMAN_DECODE_ROOT_BITS of the bit
+ * buffer index the root table; codes longer than that land on a LINK entry
+ * that points at a sub-table indexed by the next 'bits' bits.  Leaf entries
+ * hold the symbol and its full code length.  Unused patterns of an
+ * incomplete code hold HUFFMAN_DECODE_INVALID, longer than any code.
+ */
+#define HUFFMAN_DECODE_ROOT_BITS 10
+#define HUFFMAN_DECODE_SUB_BITS 10
+#define HUFFMAN_DECODE_LINK 0x01
+#define HUFFMAN_DECODE_INVALID 0xff
+#define HUFFMAN_DECODE_MAX_ENTRIES 65536        /* 'next' is 16 bits */
+
+struct _huffman_decode_entry {
+    uint16_t next;                      /* Symbol (leaf) or sub-table offset (link) */
+    uint8_t bits;                       /* Code length (leaf) or sub-table index width (link) */
+    uint8_t flags;
+};
+
+/*
+ * A trained code: the encode table, indexed by symbol like hpack_table,
+ * and its decode table.
+ */
+struct huffman_codebook {
+    struct _hpack_table codes[HPACK_SIZE];
+    struct _huffman_decode_entry decode[];
+};
+
+/*
+ * Lays out the decode table for the HPACK_SIZE 'codes' into 'tbl'.  With a
+ * NULL 'tbl' it only counts the entries.  Returns the number of entries.
+ */
+int huffman_build_decode_table( const struct _hpack_table *codes, struct _huffman_decode_entry *tbl );
+
+#endif /* HUFFMAN_BUILD_H */
@@ -0,0 +1,239 @@
+/*
+ * File:   huffman_cache.c
+ *
+ * Bounded cache of coded strings.  The arena given to the cache is cut
+ * into shards, each with its own lock, a small set-associative index and
+ * a ring of entry data.  New entries are appended to the ring and
+ * silently replace the oldest ones, so the cache never allocates after
+ * huffman_cache_create() and never needs a free list.
+ */
+
+#include <pthread.h>
+
+#include "huffman.h"
+
+#define HUFFMAN_CACHE_SHARDS 16                 /* Power of two; picked by the top hash bits */
+#define HUFFMAN_CACHE_SHARD_BITS 4
+#define HUFFMAN_CACHE_WAYS 4                    /* Slots per index bucket */
+#define HUFFMAN_CACHE_DECODED 0x80000000u       /* Set in 'klen' for decoded values */
+
+/*
+ * Index slot.  'pos' counts bytes ever written to the shard's ring, so
+ * an entry is still intact exactly while it lies within the last 'size'
+ * bytes written.
+ */
+struct _huffman_cache_slot {
+    uint64_t hash;                              /* ZERO when never used */
+    uint64_t pos;
+    uint32_t klen;                              /* Key length, plus HUFFMAN_CACHE_DECODED */
+    uint32_t vlen;
+};
+
+struct _huffman_cache_shard {
+    pthread_mutex_t lock;
+    struct _huffman_cache_slot *slots;
+    uint8_t *data;
+    uint64_t head;                              /* Bytes ever written to 'data' */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint32_t mask;                              /* Index buckets - 1 */
+    uint32_t size;                              /* Size of 'data', a power of two */
+} __attribute__((aligned(64)));
+
+struct huffman_cache {
+    struct _huffman_cache_shard shard[HUFFMAN_CACHE_SHARDS];
+    size_t bytes;
+};
+
+static size_t huffman_cache_pow2( size_t n ) {
+    size_t p = 1;
+
+    while (p <= n / 2) p <<= 1;
+    return p;
+}
+
+/*
+ * Multiply-xorshift hash, 8 octets per step.  It is not meant to resist
+ * chosen inputs and does not have to: a bucket holds a fixed number of
+ * slots, so colliding keys only evict each other.
+ */
+static uint64_t huffman_cache_hash( const uint8_t *p, int len, uint64_t seed ) {
+    const uint64_t k = 0x9e3779b97f4a7c15ULL;
+    uint64_t h = seed ^ ((uint64_t)len * k), w = 0;
+    int i = 0;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * k;
+        h ^= h >> 31;
+    }
+    w = 0;
+    memcpy(&w, p + i, len - i);
+    h = (h ^ w) * k;
+    h ^= h >> 32;
+    h *= k;
+    h ^= h >> 29;
+    return h | 1;
+}
+
+static inline int huffman_cache_live( const struct _huffman_cache_shard *s, const struct _huffman_cache_slot *sl ) {
+    return sl->hash && sl->pos + s->size >= s->head;
+}
+
+struct huffman_cache *huffman_cache_create(size_t size) {
+    struct huffman_cache *cache = 0;
+    struct _huffman_cache_shard *s = 0;
+    size_t budget = 0, data = 0, slots = 0;
+    uint8_t *p = 0;
+    int i = 0;
+
+    if (size < HUFFMAN_CACHE_MIN_SIZE) return 0;
+
+    /* Each shard gets the largest power-of-two ring that leaves a quarter for its index */
+    budget = (size - sizeof(*cache)) / HUFFMAN_CACHE_SHARDS;
+    data = huffman_cache_pow2(budget - budget / 4);
+    if (data > UINT32_MAX / 2 + 1) data = UINT32_MAX / 2 + 1;
+    slots = huffman_cache_pow2((budget - data) / sizeof(struct _huffman_cache_slot));
+    if (slots < HUFFMAN_CACHE_WAYS) return 0;
+
+    /* The shards are cache-line aligned so they do not share lines */
+    if (posix_memalign((void **)&cache, 64, sizeof(*cache) + HUFFMAN_CACHE_SHARDS * (slots * sizeof(struct _huffman_cache_slot) + data))) return 0;
+    cache->bytes = sizeof(*cache) + HUFFMAN_CACHE_SHARDS * (slots * sizeof(struct _huffman_cache_slot) + data);
+    p = (uint8_t *)(cache + 1);
+    for (i = 0; i < HUFFMAN_CACHE_SHARDS; i++) {
+        s = &cache->shard[i];
+        pthread_mutex_init(&s->lock, 0);
+        s->slots = (struct _huffman_cache_slot *)p;
+        p += slots * sizeof(struct _huffman_cache_slot);
+        s->data = p;
+        p += data;
+        huffman_zero_mem(s->slots, slots * sizeof(struct _huffman_cache_slot));
+        s->head = 0;
+        s->hits = s->misses = s->insertions = 0;
+        s->mask = (uint32_t)(slots / HUFFMAN_CACHE_WAYS - 1);
+        s->size = (uint32_t)data;
+    }
+    return cache;
+}
+
+void huffman_cache_destroy(struct huffman_cache *cache) {
+    int i = 0;
+
+    if (!cache) return;
+    for (i = 0; i < HUFFMAN_CACHE_SHARDS; i++) pthread_mutex_destroy(&cache->shard[i].lock);
+    free(cache);
+}
+
+/*
+ * Looks 'input' up and copies its value to 'output' when it fits.
+ * Returns the length of the value, or -1 when it is not cached.
+ */
+static int huffman_cache_find( struct _huffman_cache_shard *s, uint64_t h, uint32_t key, const uint8_t *input, int inlen, void *output, int outcap ) {
+    struct _huffman_cache_slot *sl = &s->slots[(h & s->mask) * HUFFMAN_CACHE_WAYS];
+    const uint8_t *entry = 0;
+    int w = 0, n = -1;
+
+    pthread_mutex_lock(&s->lock);
+    for (w = 0; w < HUFFMAN_CACHE_WAYS; w++, sl++) {
+        if (sl->hash != h || sl->klen != key || !huffman_cache_live(s, sl)) continue;
+        entry = s->data + (sl->pos & (s->size - 1));
+        if (memcmp(entry, input, inlen)) continue;
+        n = (int)sl->vlen;
+        if (output && n <= outcap) memcpy(output, entry + inlen, n);
+        break;
+    }
+    if (n < 0) s->misses++;
+    else s->hits++;
+    pthread_mutex_unlock(&s->lock);
+    return n;
+}
+
+/*
+ * Appends key and value to the shard's ring and points a slot at them,
+ * reusing a dead slot, the key's own or else the oldest in its bucket.
+ */
+static void huffman_cache_insert( struct _huffman_cache_shard *s, uint64_t h, uint32_t key, const uint8_t *input, int inlen, const void *value, int vlen ) {
+    struct _huffman_cache_slot *bucket = &s->slots[(h & s->mask) * HUFFMAN_CACHE_WAYS], *sl = 0;
+    uint64_t pos = 0, total = (uint64_t)inlen + (uint64_t)vlen;
+    uint32_t off = 0;
+    int w = 0;
+
+    if (total > s->size / 4) return;            /* Would push out too much at once */
+
+    pthread_mutex_lock(&s->lock);
+    pos = s->head;
+    off = (uint32_t)(pos & (s->size - 1));
+    if (off + total > s->size) pos += s->size - off;        /* Entries never wrap */
+    s->head = pos + total;
+    memcpy(s->data + (pos & (s->size - 1)), input, inlen);
+    memcpy(s->data + (pos & (s->size - 1)) + inlen, value, vlen);
+
+    for (w = 0; w < HUFFMAN_CACHE_WAYS; w++) {
+        if (!huffman_cache_live(s, &bucket[w]) || (bucket[w].hash == h && bucket[w].klen == key)) {
+            sl = &bucket[w];
+            break;
+        }
+        if (!sl || bucket[w].pos < sl->pos) sl = &bucket[w];
+    }
+    sl->hash = h;
+    sl->pos = pos;
+    sl->klen = key;
+    sl->vlen = (uint32_t)vlen;
+    s->insertions++;
+    pthread_mutex_unlock(&s->lock);
+}
+
+int huffman_cache_encode(struct huffman_cache *cache, const uint8_t *input, int inlen, uint8_t *output, int outcap) {
+    struct _huffman_cache_shard *s = 0;
+    uint64_t h = 0;
+    int len = 0;
+
+    if (!cache) return huffman_encode(input, inlen, output, outcap);
+    if (inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_BAD_PARAMETER;
+
+    h = huffman_cache_hash(input, inlen, 0);
+    s = &cache->shard[h >> (64 - HUFFMAN_CACHE_SHARD_BITS)];
+    len = huffman_cache_find(s, h, (uint32_t)inlen, input, inlen, output, outcap);
+    if (len >= 0) return len;
+
+    len = huffman_encode(input, inlen, output, outcap);
+    if (len >= 0 && output && len <= outcap) huffman_cache_insert(s, h, (uint32_t)inlen, input, inlen, output, len);
+    return len;
+}
+
+int huffman_cache_decode(struct huffman_cache *cache, const uint8_t *input, int inlen, char *output, int outcap) {
+    struct _huffman_cache_shard *s = 0;
+    uint64_t h = 0;
+    int len = 0;
+
+    if (!cache) return huffman_decode(input, inlen, output, outcap);
+    if (inlen < 0 || (!input && inlen) || outcap < 0) return HUFFMAN_BAD_PARAMETER;
+
+    h = huffman_cache_hash(input, inlen, HUFFMAN_CACHE_DECODED);
+    s = &cache->shard[h >> (64 - HUFFMAN_CACHE_SHARD_BITS)];
+    len = huffman_cache_find(s, h, (uint32_t)inlen | HUFFMAN_CACHE_DECODED, input, inlen, output, outcap);
+    if (len >= 0) return len;
+
+    len = huffman_decode(input, inlen, output, outcap);
+    if (len >= 0 && output && len <= outcap) huffman_cache_insert(s, h, (uint32_t)inlen | HUFFMAN_CACHE_DECODED, input, inlen, output, len);
+    return len;
+}
+
+int huffman_cache_get_stats(struct huffman_cache *cache, struct huffman_cache_stats *stats) {
+    struct _huffman_cache_shard *s = 0;
+    int i = 0;
+
+    if (!cache || !stats) return HUFFMAN_BAD_PARAMETER;
+    huffman_zero_mem(stats, sizeof(*stats));
+    for (i = 0; i < HUFFMAN_CACHE_SHARDS; i++) {
+        s = &cache->shard[i];
+        pthread_mutex_lock(&s->lock);
+        stats->hits += s->hits;
+        stats->misses += s->misses;
+        stats->insertions += s->insertions;
+        pthread_mutex_unlock(&s->lock);
+    }
+    stats->bytes = cache->bytes;
+    return HUFFMAN_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+ * File:   huffman_codebook.c
+ *
+ * Trained codebooks: length-limited canonical Huffman codes built from
+ * octet frequencies, their serialized form, and the encode and decode
+ * tables huffman_codebook_encode() / huffman_codebook_decode() run on.
+ */
+
+#include "huffman.h"
+#include "huffman_build.h"
+
+#define HUFFMAN_CODEBOOK_VERSION 1
+#define HUFFMAN_CODEBOOK_LEN_BITS 5             /* Bits per serialized code length */
+
+struct _huffman_codebook_leaf {
+    uint64_t weight;
+    int symbol;
+};
+
+/*
+ * Lightest first; among equal weights the higher symbol first, so EOS
+ * (weight 0, the highest symbol) is always the lightest leaf.
+ */
+static int huffman_codebook_cmp( const void *a, const void *b ) {
+    const struct _huffman_codebook_leaf *x = (const struct _huffman_codebook_leaf *)a;
+    const struct _huffman_codebook_leaf *y = (const struct _huffman_codebook_leaf *)b;
+
+    if (x->weight != y->weight) return (x->weight < y->weight) ? -1 : 1;
+    return y->symbol - x->symbol;
+}
+
+/*
+ * Huffman code lengths for 'weights', limited to 'max_bits'.  The tree is
+ * built with two queues over the sorted leaves, which needs no heap; only
+ * the number of codes of each length is kept from it.  Lengths over the
+ * limit are then folded back in the way JPEG does (ITU T.81 annex K.3):
+ * two codes at the deepest level become one a level up plus two below a
+ * shallower code, which keeps the code complete.  Finally the lengths
+ * are handed out longest first to the lightest leaves.
+ */
+static void huffman_codebook_lengths( const uint64_t *weights, int max_bits, uint8_t *lengths ) {
+    struct _huffman_codebook_leaf leaf[HPACK_SIZE];
+    uint64_t weight[2 * HPACK_SIZE - 1];
+    int parent[2 * HPACK_SIZE - 1], depth[2 * HPACK_SIZE - 1], count[2 * HPACK_SIZE];
+    int i = 0, j = 0, next_leaf = 0, next_node = HPACK_SIZE, node = 0, pick[2], deepest = 0;
+
+    for (i = 0; i < HPACK_SIZE; i++) {
+        leaf[i].weight = weights[i];
+        leaf[i].symbol = i;
+    }
+    qsort(leaf, HPACK_SIZE, sizeof(leaf[0]), huffman_codebook_cmp);
+    for (i = 0; i < HPACK_SIZE; i++) weight[i] = leaf[i].weight;
+
+    /* Internal nodes come out in order of weight, so the two queues stay sorted */
+    for (node = HPACK_SIZE; node < 2 * HPACK_SIZE - 1; node++) {
+        for (j = 0; j < 2; j++) {
+            if (next_leaf < HPACK_SIZE && (next_node == node || weight[next_leaf] <= weight[next_node])) pick[j] = next_leaf++;
+            else pick[j] = next_node++;
+            parent[pick[j]] = node;
+        }
+        weight[node] = weight[pick[0]] + weight[pick[1]];
+        if (weight[node] < weight[pick[0]]) weight[node] = UINT64_MAX;
+    }
+
+    huffman_zero_mem(count, sizeof(count));
+    depth[2 * HPACK_SIZE - 2] = 0;
+    for (node = 2 * HPACK_SIZE - 3; node >= 0; node--) {
+        depth[node] = depth[parent[node]] + 1;
+        if (node < HPACK_SIZE) {
+            count[depth[node]]++;
+            if (depth[node] > deepest) deepest = depth[node];
+        }
+    }
+
+    for (i = deepest; i > max_bits; i--) {
+        while (count[i] > 0) {
+            for (j = i - 2; !count[j]; j--);
+            count[i] -= 2;
+            count[i-1]++;
+            count[j+1] += 2;
+            count[j]--;
+        }
+    }
+
+    for (i = 0, j = max_bits; i < HPACK_SIZE; i++) {
+        while (!count[j]) j--;
+        lengths[leaf[i].symbol] = (uint8_t)j;
+        count[j]--;
+    }
+}
+
+/*
+ * Makes the canonical code for 'lengths' (codes of one length are
+ * consecutive and in symbol order) and lays out its decode table.  The
+ * lengths must describe a complete code.
+ */
+static struct huffman_codebook *huffman_codebook_create( const uint8_t *lengths ) {
+    struct _hpack_table codes[HPACK_SIZE];
+    struct huffman_codebook *cb = 0;
+    uint32_t next[HUFFMAN_CODEBOOK_MAX_BITS + 1], code = 0;
+    int count[HUFFMAN_CODEBOOK_MAX_BITS + 1], i = 0, entries = 0;
+
+    huffman_zero_mem(count, sizeof(count));
+    for (i = 0; i < HPACK_SIZE; i++) count[lengths[i]]++;
+    for (i = 1; i <= HUFFMAN_CODEBOOK_MAX_BITS; i++) {
+        code = (code + (uint32_t)count[i-1]) << 1;
+        next[i] = code;
+    }
+    for (i = 0; i < HPACK_SIZE; i++) {
+        codes[i].value = next[lengths[i]]++;
+        codes[i].bits = lengths[i];
+        codes[i].charval = (uint32_t)i;
+    }
+
+    entries = huffman_build_decode_table(codes, 0);
+    if (entries > HUFFMAN_DECODE_MAX_ENTRIES) return 0;
+    cb = (struct huffman_codebook *)malloc(sizeof(*cb) + entries * sizeof(struct _huffman_decode_entry));
+    if (!cb) return 0;
+    memcpy(cb->codes, codes, sizeof(codes));
+    huffman_build_decode_table(codes, cb->decode);
+    return cb;
+}
+
+struct huffman_codebook *huffman_codebook_build(const uint64_t histogram[256], int max_bits) {
+    uint64_t weights[HPACK_SIZE];
+    uint8_t lengths[HPACK_SIZE];
+
+    if (!histogram || max_bits < HUFFMAN_CODEBOOK_MIN_BITS || max_bits > HUFFMAN_CODEBOOK_MAX_BITS) return 0;
+    memcpy(weights, histogram, 256 * sizeof(uint64_t));
+    weights[HPACK_EOS] = 0;
+    huffman_codebook_lengths(weights, max_bits, lengths);
+    return huffman_codebook_create(lengths);
+}
+
+struct huffman_codebook *huffman_codebook_train(const struct huffman_string *samples, int count, int max_bits) {
+    uint64_t histogram[256];
+    int i = 0, k = 0;
+
+    if (count < 0 || (!samples && count)) return 0;
+    huffman_zero_mem(histogram, sizeof(histogram));
+    for (i = 0; i < count; i++) {
+        if (samples[i].len < 0 || (!samples[i].data && samples[i].len)) return 0;
+        for (k = 0; k < samples[i].len; k++) histogram[samples[i].data[k]]++;
+    }
+    return huffman_codebook_build(histogram, max_bits);
+}
+
+int huffman_codebook_serialize(const struct huffman_codebook *cb, uint8_t *output, int outcap) {
+    uint32_t acc = 0;
+    int i = 0, n = 0, pos = 1;
+
+    if (!cb) return HUFFMAN_BAD_PARAMETER;
+    if (!output || outcap < HUFFMAN_CODEBOOK_SIZE) return HUFFMAN_CODEBOOK_SIZE;
+    output[0] = HUFFMAN_CODEBOOK_VERSION;
+    for (i = 0; i < HPACK_SIZE; i++) {
+        acc = (acc << HUFFMAN_CODEBOOK_LEN_BITS) | cb->codes[i].bits;
+        n += HUFFMAN_CODEBOOK_LEN_BITS;
+        while (n >= 8) {
+            n -= 8;
+            output[pos++] = (uint8_t)(acc >> n);
+        }
+    }
+    if (n) output[pos++] = (uint8_t)(acc << (8 - n));
+    return pos;
+}
+
+struct huffman_codebook *huffman_codebook_load(const uint8_t *input, int inlen) {
+    uint8_t lengths[HPACK_SIZE];
+    uint64_t kraft = 0;
+    uint32_t acc = 0;
+    int i = 0, n = 0, pos = 1, longest = 0;
+
+    if (!input || inlen != HUFFMAN_CODEBOOK_SIZE || input[0] != HUFFMAN_CODEBOOK_VERSION) return 0;
+    for (i = 0; i < HPACK_SIZE; i++) {
+        while (n < HUFFMAN_CODEBOOK_LEN_BITS) {
+            acc = (acc << 8) | input[pos++];
+            n += 8;
+        }
+        n -= HUFFMAN_CODEBOOK_LEN_BITS;
+        lengths[i] = (uint8_t)((acc >> n) & ((1 << HUFFMAN_CODEBOOK_LEN_BITS) - 1));
+        if (!lengths[i] || lengths[i] > HUFFMAN_CODEBOOK_MAX_BITS) return 0;
+        kraft += (uint64_t)1 << (HUFFMAN_CODEBOOK_MAX_BITS - lengths[i]);
+        if (lengths[i] > longest) longest = lengths[i];
+    }
+
+    /* Complete, with EOS among the longest codes: then its code is all ones */
+    if (kraft != (uint64_t)1 << HUFFMAN_CODEBOOK_MAX_BITS || lengths[HPACK_EOS] != longest) return 0;
+    return huffman_codebook_create(lengths);
+}
+
+void huffman_codebook_destroy(struct huffman_codebook *cb) {
+    free(cb);
+}
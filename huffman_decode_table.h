@@ -0,0 +1,407 @@
+/*
+ * Generated by tools/huffman_gen.c from hpack_table.inc.  Do not edit.
+ *
+ * Multi-level decode table: 10-bit root, sub-tables of up to 10 bits.
+ * Entries are {symbol or sub-table offset, code length or sub-table
+ * width, flags}.
+ */
+
+#define HUFFMAN_DECODE_TABLE_SIZE 3158
+
+static const struct _huffman_decode_entry huffman_decode_table[HUFFMAN_DECODE_TABLE_SIZE] = {
+    {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0},
+    {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0},
+    {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0},
+    {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0}, {48,5,0},
+    {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0},
+    {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0},
+    {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0},
+    {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0}, {49,5,0},
+    {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0},
+    {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0},
+    {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0},
+    {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0}, {50,5,0},
+    {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0},
+    {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0},
+    {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0},
+    {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0}, {97,5,0},
+    {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0},
+    {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0},
+    {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0},
+    {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0}, {99,5,0},
+    {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0},
+    {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0},
+    {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0},
+    {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0}, {101,5,0},
+    {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0},
+    {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0},
+    {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0},
+    {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0}, {105,5,0},
+    {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0},
+    {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0},
+    {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0},
+    {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0}, {111,5,0},
+    {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0},
+    {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0},
+    {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0},
+    {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0}, {115,5,0},
+    {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0},
+    {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0},
+    {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0},
+    {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0}, {116,5,0},
+    {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0},
+    {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0}, {32,6,0},
+    {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0},
+    {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0}, {37,6,0},
+    {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0},
+    {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0}, {45,6,0},
+    {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0},
+    {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0}, {46,6,0},
+    {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0},
+    {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0}, {47,6,0},
+    {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0},
+    {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0}, {51,6,0},
+    {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0},
+    {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0}, {52,6,0},
+    {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0},
+    {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0}, {53,6,0},
+    {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0},
+    {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0}, {54,6,0},
+    {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0},
+    {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0}, {55,6,0},
+    {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0},
+    {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0}, {56,6,0},
+    {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0},
+    {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0}, {57,6,0},
+    {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0},
+    {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0}, {61,6,0},
+    {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0},
+    {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0}, {65,6,0},
+    {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0},
+    {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0}, {95,6,0},
+    {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0},
+    {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0}, {98,6,0},
+    {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0},
+    {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0}, {100,6,0},
+    {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0},
+    {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0}, {102,6,0},
+    {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0},
+    {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0}, {103,6,0},
+    {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0},
+    {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0}, {104,6,0},
+    {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0},
+    {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0}, {108,6,0},
+    {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0},
+    {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0}, {109,6,0},
+    {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0},
+    {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0}, {110,6,0},
+    {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0},
+    {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0}, {112,6,0},
+    {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0},
+    {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0}, {114,6,0},
+    {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0},
+    {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0}, {117,6,0},
+    {58,7,0}, {58,7,0}, {58,7,0}, {58,7,0}, {58,7,0}, {58,7,0}, {58,7,0}, {58,7,0},
+    {66,7,0}, {66,7,0}, {66,7,0}, {66,7,0}, {66,7,0}, {66,7,0}, {66,7,0}, {66,7,0},
+    {67,7,0}, {67,7,0}, {67,7,0}, {67,7,0}, {67,7,0}, {67,7,0}, {67,7,0}, {67,7,0},
+    {68,7,0}, {68,7,0}, {68,7,0}, {68,7,0}, {68,7,0}, {68,7,0}, {68,7,0}, {68,7,0},
+    {69,7,0}, {69,7,0}, {69,7,0}, {69,7,0}, {69,7,0}, {69,7,0}, {69,7,0}, {69,7,0},
+    {70,7,0}, {70,7,0}, {70,7,0}, {70,7,0}, {70,7,0}, {70,7,0}, {70,7,0}, {70,7,0},
+    {71,7,0}, {71,7,0}, {71,7,0}, {71,7,0}, {71,7,0}, {71,7,0}, {71,7,0}, {71,7,0},
+    {72,7,0}, {72,7,0}, {72,7,0}, {72,7,0}, {72,7,0}, {72,7,0}, {72,7,0}, {72,7,0},
+    {73,7,0}, {73,7,0}, {73,7,0}, {73,7,0}, {73,7,0}, {73,7,0}, {73,7,0}, {73,7,0},
+    {74,7,0}, {74,7,0}, {74,7,0}, {74,7,0}, {74,7,0}, {74,7,0}, {74,7,0}, {74,7,0},
+    {75,7,0}, {75,7,0}, {75,7,0}, {75,7,0}, {75,7,0}, {75,7,0}, {75,7,0}, {75,7,0},
+    {76,7,0}, {76,7,0}, {76,7,0}, {76,7,0}, {76,7,0}, {76,7,0}, {76,7,0}, {76,7,0},
+    {77,7,0}, {77,7,0}, {77,7,0}, {77,7,0}, {77,7,0}, {77,7,0}, {77,7,0}, {77,7,0},
+    {78,7,0}, {78,7,0}, {78,7,0}, {78,7,0}, {78,7,0}, {78,7,0}, {78,7,0}, {78,7,0},
+    {79,7,0}, {79,7,0}, {79,7,0}, {79,7,0}, {79,7,0}, {79,7,0}, {79,7,0}, {79,7,0},
+    {80,7,0}, {80,7,0}, {80,7,0}, {80,7,0}, {80,7,0}, {80,7,0}, {80,7,0}, {80,7,0},
+    {81,7,0}, {81,7,0}, {81,7,0}, {81,7,0}, {81,7,0}, {81,7,0}, {81,7,0}, {81,7,0},
+    {82,7,0}, {82,7,0}, {82,7,0}, {82,7,0}, {82,7,0}, {82,7,0}, {82,7,0}, {82,7,0},
+    {83,7,0}, {83,7,0}, {83,7,0}, {83,7,0}, {83,7,0}, {83,7,0}, {83,7,0}, {83,7,0},
+    {84,7,0}, {84,7,0}, {84,7,0}, {84,7,0}, {84,7,0}, {84,7,0}, {84,7,0}, {84,7,0},
+    {85,7,0}, {85,7,0}, {85,7,0}, {85,7,0}, {85,7,0}, {85,7,0}, {85,7,0}, {85,7,0},
+    {86,7,0}, {86,7,0}, {86,7,0}, {86,7,0}, {86,7,0}, {86,7,0}, {86,7,0}, {86,7,0},
+    {87,7,0}, {87,7,0}, {87,7,0}, {87,7,0}, {87,7,0}, {87,7,0}, {87,7,0}, {87,7,0},
+    {89,7,0}, {89,7,0}, {89,7,0}, {89,7,0}, {89,7,0}, {89,7,0}, {89,7,0}, {89,7,0},
+    {106,7,0}, {106,7,0}, {106,7,0}, {106,7,0}, {106,7,0}, {106,7,0}, {106,7,0}, {106,7,0},
+    {107,7,0}, {107,7,0}, {107,7,0}, {107,7,0}, {107,7,0}, {107,7,0}, {107,7,0}, {107,7,0},
+    {113,7,0}, {113,7,0}, {113,7,0}, {113,7,0}, {113,7,0}, {113,7,0}, {113,7,0}, {113,7,0},
+    {118,7,0}, {118,7,0}, {118,7,0}, {118,7,0}, {118,7,0}, {118,7,0}, {118,7,0}, {118,7,0},
+    {119,7,0}, {119,7,0}, {119,7,0}, {119,7,0}, {119,7,0}, {119,7,0}, {119,7,0}, {119,7,0},
+    {120,7,0}, {120,7,0}, {120,7,0}, {120,7,0}, {120,7,0}, {120,7,0}, {120,7,0}, {120,7,0},
+    {121,7,0}, {121,7,0}, {121,7,0}, {121,7,0}, {121,7,0}, {121,7,0}, {121,7,0}, {121,7,0},
+    {122,7,0}, {122,7,0}, {122,7,0}, {122,7,0}, {122,7,0}, {122,7,0}, {122,7,0}, {122,7,0},
+    {38,8,0}, {38,8,0}, {38,8,0}, {38,8,0}, {42,8,0}, {42,8,0}, {42,8,0}, {42,8,0},
+    {44,8,0}, {44,8,0}, {44,8,0}, {44,8,0}, {59,8,0}, {59,8,0}, {59,8,0}, {59,8,0},
+    {88,8,0}, {88,8,0}, {88,8,0}, {88,8,0}, {90,8,0}, {90,8,0}, {90,8,0}, {90,8,0},
+    {33,10,0}, {34,10,0}, {40,10,0}, {41,10,0}, {63,10,0}, {1024,1,1}, {1026,2,1}, {1030,10,1},
+    {39,11,0}, {43,11,0}, {124,11,0}, {124,11,0}, {35,12,0}, {62,12,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0},
+    {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {0,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0},
+    {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {36,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0},
+    {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {64,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0},
+    {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {91,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0},
+    {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {93,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0},
+    {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {126,13,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0},
+    {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {94,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0},
+    {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {125,14,0}, {60,15,0}, {60,15,0},
+    {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0},
+    {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0},
+    {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0},
+    {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {60,15,0}, {96,15,0}, {96,15,0},
+    {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0},
+    {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0},
+    {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0},
+    {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {96,15,0}, {123,15,0}, {123,15,0},
+    {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0},
+    {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0},
+    {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0},
+    {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {123,15,0}, {92,19,0}, {92,19,0},
+    {195,19,0}, {195,19,0}, {208,19,0}, {208,19,0}, {128,20,0}, {130,20,0}, {131,20,0}, {162,20,0},
+    {184,20,0}, {194,20,0}, {224,20,0}, {226,20,0}, {2054,1,1}, {2056,1,1}, {2058,1,1}, {2060,1,1},
+    {2062,1,1}, {2064,1,1}, {2066,2,1}, {2070,2,1}, {2074,2,1}, {2078,2,1}, {2082,2,1}, {2086,2,1},
+    {2090,2,1}, {2094,3,1}, {2102,3,1}, {2110,3,1}, {2118,4,1}, {2134,10,1}, {153,21,0}, {161,21,0},
+    {167,21,0}, {172,21,0}, {176,21,0}, {177,21,0}, {179,21,0}, {209,21,0}, {216,21,0}, {217,21,0},
+    {227,21,0}, {229,21,0}, {230,21,0}, {230,21,0}, {129,22,0}, {132,22,0}, {133,22,0}, {134,22,0},
+    {136,22,0}, {146,22,0}, {154,22,0}, {156,22,0}, {160,22,0}, {163,22,0}, {164,22,0}, {169,22,0},
+    {170,22,0}, {173,22,0}, {178,22,0}, {181,22,0}, {185,22,0}, {186,22,0}, {187,22,0}, {189,22,0},
+    {190,22,0}, {196,22,0}, {198,22,0}, {228,22,0}, {232,22,0}, {233,22,0}, {1,23,0}, {135,23,0},
+    {137,23,0}, {138,23,0}, {139,23,0}, {140,23,0}, {141,23,0}, {143,23,0}, {147,23,0}, {149,23,0},
+    {150,23,0}, {151,23,0}, {152,23,0}, {155,23,0}, {157,23,0}, {158,23,0}, {165,23,0}, {166,23,0},
+    {168,23,0}, {174,23,0}, {175,23,0}, {180,23,0}, {182,23,0}, {183,23,0}, {188,23,0}, {188,23,0},
+    {191,23,0}, {191,23,0}, {197,23,0}, {197,23,0}, {231,23,0}, {231,23,0}, {239,23,0}, {239,23,0},
+    {9,24,0}, {142,24,0}, {144,24,0}, {145,24,0}, {148,24,0}, {159,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0},
+    {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {171,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0},
+    {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {206,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0},
+    {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {215,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0},
+    {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {225,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0},
+    {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {236,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0},
+    {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {237,24,0}, {199,25,0}, {199,25,0},
+    {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0},
+    {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0},
+    {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0},
+    {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {199,25,0}, {207,25,0}, {207,25,0},
+    {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0},
+    {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0},
+    {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0},
+    {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {207,25,0}, {234,25,0}, {234,25,0},
+    {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0},
+    {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0},
+    {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0},
+    {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {234,25,0}, {235,25,0}, {235,25,0},
+    {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0},
+    {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0},
+    {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0},
+    {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {235,25,0}, {192,26,0}, {192,26,0},
+    {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0},
+    {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {192,26,0}, {193,26,0}, {193,26,0},
+    {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0},
+    {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {193,26,0}, {200,26,0}, {200,26,0},
+    {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0},
+    {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {200,26,0}, {201,26,0}, {201,26,0},
+    {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0},
+    {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {201,26,0}, {202,26,0}, {202,26,0},
+    {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0},
+    {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {202,26,0}, {205,26,0}, {205,26,0},
+    {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0},
+    {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {205,26,0}, {210,26,0}, {210,26,0},
+    {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0},
+    {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {210,26,0}, {213,26,0}, {213,26,0},
+    {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0},
+    {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {213,26,0}, {218,26,0}, {218,26,0},
+    {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0},
+    {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {218,26,0}, {219,26,0}, {219,26,0},
+    {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0},
+    {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {219,26,0}, {238,26,0}, {238,26,0},
+    {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0},
+    {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {238,26,0}, {240,26,0}, {240,26,0},
+    {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0},
+    {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {240,26,0}, {242,26,0}, {242,26,0},
+    {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0},
+    {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {242,26,0}, {243,26,0}, {243,26,0},
+    {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0},
+    {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {243,26,0}, {255,26,0}, {255,26,0},
+    {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0},
+    {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {255,26,0}, {203,27,0}, {203,27,0},
+    {203,27,0}, {203,27,0}, {203,27,0}, {203,27,0}, {203,27,0}, {203,27,0}, {204,27,0}, {204,27,0},
+    {204,27,0}, {204,27,0}, {204,27,0}, {204,27,0}, {204,27,0}, {204,27,0}, {211,27,0}, {211,27,0},
+    {211,27,0}, {211,27,0}, {211,27,0}, {211,27,0}, {211,27,0}, {211,27,0}, {212,27,0}, {212,27,0},
+    {212,27,0}, {212,27,0}, {212,27,0}, {212,27,0}, {212,27,0}, {212,27,0}, {214,27,0}, {214,27,0},
+    {214,27,0}, {214,27,0}, {214,27,0}, {214,27,0}, {214,27,0}, {214,27,0}, {221,27,0}, {221,27,0},
+    {221,27,0}, {221,27,0}, {221,27,0}, {221,27,0}, {221,27,0}, {221,27,0}, {222,27,0}, {222,27,0},
+    {222,27,0}, {222,27,0}, {222,27,0}, {222,27,0}, {222,27,0}, {222,27,0}, {223,27,0}, {223,27,0},
+    {223,27,0}, {223,27,0}, {223,27,0}, {223,27,0}, {223,27,0}, {223,27,0}, {241,27,0}, {241,27,0},
+    {241,27,0}, {241,27,0}, {241,27,0}, {241,27,0}, {241,27,0}, {241,27,0}, {244,27,0}, {244,27,0},
+    {244,27,0}, {244,27,0}, {244,27,0}, {244,27,0}, {244,27,0}, {244,27,0}, {245,27,0}, {245,27,0},
+    {245,27,0}, {245,27,0}, {245,27,0}, {245,27,0}, {245,27,0}, {245,27,0}, {246,27,0}, {246,27,0},
+    {246,27,0}, {246,27,0}, {246,27,0}, {246,27,0}, {246,27,0}, {246,27,0}, {247,27,0}, {247,27,0},
+    {247,27,0}, {247,27,0}, {247,27,0}, {247,27,0}, {247,27,0}, {247,27,0}, {248,27,0}, {248,27,0},
+    {248,27,0}, {248,27,0}, {248,27,0}, {248,27,0}, {248,27,0}, {248,27,0}, {250,27,0}, {250,27,0},
+    {250,27,0}, {250,27,0}, {250,27,0}, {250,27,0}, {250,27,0}, {250,27,0}, {251,27,0}, {251,27,0},
+    {251,27,0}, {251,27,0}, {251,27,0}, {251,27,0}, {251,27,0}, {251,27,0}, {252,27,0}, {252,27,0},
+    {252,27,0}, {252,27,0}, {252,27,0}, {252,27,0}, {252,27,0}, {252,27,0}, {253,27,0}, {253,27,0},
+    {253,27,0}, {253,27,0}, {253,27,0}, {253,27,0}, {253,27,0}, {253,27,0}, {254,27,0}, {254,27,0},
+    {254,27,0}, {254,27,0}, {254,27,0}, {254,27,0}, {254,27,0}, {254,27,0}, {2,28,0}, {2,28,0},
+    {2,28,0}, {2,28,0}, {3,28,0}, {3,28,0}, {3,28,0}, {3,28,0}, {4,28,0}, {4,28,0},
+    {4,28,0}, {4,28,0}, {5,28,0}, {5,28,0}, {5,28,0}, {5,28,0}, {6,28,0}, {6,28,0},
+    {6,28,0}, {6,28,0}, {7,28,0}, {7,28,0}, {7,28,0}, {7,28,0}, {8,28,0}, {8,28,0},
+    {8,28,0}, {8,28,0}, {11,28,0}, {11,28,0}, {11,28,0}, {11,28,0}, {12,28,0}, {12,28,0},
+    {12,28,0}, {12,28,0}, {14,28,0}, {14,28,0}, {14,28,0}, {14,28,0}, {15,28,0}, {15,28,0},
+    {15,28,0}, {15,28,0}, {16,28,0}, {16,28,0}, {16,28,0}, {16,28,0}, {17,28,0}, {17,28,0},
+    {17,28,0}, {17,28,0}, {18,28,0}, {18,28,0}, {18,28,0}, {18,28,0}, {19,28,0}, {19,28,0},
+    {19,28,0}, {19,28,0}, {20,28,0}, {20,28,0}, {20,28,0}, {20,28,0}, {21,28,0}, {21,28,0},
+    {21,28,0}, {21,28,0}, {23,28,0}, {23,28,0}, {23,28,0}, {23,28,0}, {24,28,0}, {24,28,0},
+    {24,28,0}, {24,28,0}, {25,28,0}, {25,28,0}, {25,28,0}, {25,28,0}, {26,28,0}, {26,28,0},
+    {26,28,0}, {26,28,0}, {27,28,0}, {27,28,0}, {27,28,0}, {27,28,0}, {28,28,0}, {28,28,0},
+    {28,28,0}, {28,28,0}, {29,28,0}, {29,28,0}, {29,28,0}, {29,28,0}, {30,28,0}, {30,28,0},
+    {30,28,0}, {30,28,0}, {31,28,0}, {31,28,0}, {31,28,0}, {31,28,0}, {127,28,0}, {127,28,0},
+    {127,28,0}, {127,28,0}, {220,28,0}, {220,28,0}, {220,28,0}, {220,28,0}, {249,28,0}, {249,28,0},
+    {249,28,0}, {249,28,0}, {10,30,0}, {13,30,0}, {22,30,0}, {256,30,0}
+};
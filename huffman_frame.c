@@ -0,0 +1,425 @@
+/*
+ * File:   huffman_frame.c
+ *
+ * Framed mode for large inputs: the input is cut into blocks that are
+ * coded independently, behind an index of where each block's code ends
+ * and how long it was.  Blocks are coded in parallel on a thread pool,
+ * and any one of them can be decoded on its own.
+ *
+ * Frame layout, all integers 32-bit big-endian:
+ *
+ *      magic "HF", version, 0          4 octets
+ *      block size                      4 octets
+ *      number of blocks                4 octets
+ *      per block: end of its code (from the start of the code area),
+ *                 original length      8 octets each
+ *      the blocks' codes, back to back
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "huffman.h"
+#include "huffman_stats.h"
+
+#define HUFFMAN_FRAME_MAGIC 0x48460100u         /* "HF", version 1, no flags */
+#define HUFFMAN_FRAME_ENTRY 8                   /* Octets per index entry */
+
+/******** Thread pool ********/
+
+/*
+ * Blocks still to run for one worker, [next, end).  The worker takes from
+ * the front one block at a time; a worker that has run out steals the
+ * back half of someone else's range, so uneven blocks even out without
+ * a shared counter every thread would fight over.
+ */
+struct _huffman_pool_queue {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+} __attribute__((aligned(64)));
+
+struct _huffman_pool_job {
+    int (*run)( void *arg, int block );         /* Negative return values are errors */
+    void *arg;
+    int error;                                  /* The first error, under the pool's lock */
+};
+
+struct huffman_pool {
+    pthread_mutex_t busy;                       /* Held by the call using the pool */
+    pthread_mutex_t lock;                       /* Guards the fields below */
+    pthread_cond_t start;
+    pthread_cond_t done;
+    struct _huffman_pool_job *job;
+    unsigned generation;                        /* Bumped for every job */
+    int active;                                 /* Workers still on the job */
+    int stop;
+    int threads;                                /* Worker threads; the caller makes one more */
+    pthread_t *tid;
+    struct _huffman_pool_queue *queue;          /* One per worker, the caller's last */
+};
+
+struct _huffman_pool_worker {
+    struct huffman_pool *pool;
+    int self;
+};
+
+/* Takes the next block from queue 'self', refilling it from another queue when empty */
+static int huffman_pool_take( struct huffman_pool *pool, int self ) {
+    struct _huffman_pool_queue *q = &pool->queue[self], *v = 0;
+    int n = pool->threads + 1, k = 0, lo = 0, hi = 0, block = -1;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->next < q->end) block = q->next++;
+    pthread_mutex_unlock(&q->lock);
+    if (block >= 0) return block;
+
+    for (k = 1; k < n && block < 0; k++) {
+        v = &pool->queue[(self + k) % n];
+        pthread_mutex_lock(&v->lock);
+        if (v->next < v->end) {
+            hi = v->end;
+            lo = hi - (hi - v->next + 1) / 2;
+            v->end = lo;
+            block = lo++;
+        }
+        pthread_mutex_unlock(&v->lock);
+    }
+    if (block >= 0 && lo < hi) {
+        pthread_mutex_lock(&q->lock);
+        q->next = lo;
+        q->end = hi;
+        pthread_mutex_unlock(&q->lock);
+    }
+    return block;
+}
+
+static void huffman_pool_work( struct huffman_pool *pool, struct _huffman_pool_job *job, int self ) {
+    int block = 0, rc = 0;
+
+    while ((block = huffman_pool_take(pool, self)) >= 0) {
+        rc = job->run(job->arg, block);
+        if (rc < 0) {
+            pthread_mutex_lock(&pool->lock);
+            if (!job->error) job->error = rc;
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+}
+
+static void *huffman_pool_main( void *arg ) {
+    struct _huffman_pool_worker *w = (struct _huffman_pool_worker *)arg;
+    struct huffman_pool *pool = w->pool;
+    struct _huffman_pool_job *job = 0;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->stop) pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->stop) break;
+        seen = pool->generation;
+        job = pool->job;
+        pthread_mutex_unlock(&pool->lock);
+
+        huffman_pool_work(pool, job, w->self);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    free(w);
+    return 0;
+}
+
+struct huffman_pool *huffman_pool_create(int threads) {
+    struct huffman_pool *pool = 0;
+    struct _huffman_pool_worker *w = 0;
+    int i = 0;
+
+    if (threads < 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+        if (threads < 0) threads = 0;
+    }
+    pool = (struct huffman_pool *)calloc(1, sizeof(*pool));
+    if (!pool) return 0;
+    pool->tid = (pthread_t *)calloc(threads ? threads : 1, sizeof(pthread_t));
+    if (posix_memalign((void **)&pool->queue, 64, (threads + 1) * sizeof(struct _huffman_pool_queue))) pool->queue = 0;
+    if (!pool->tid || !pool->queue) {
+        free(pool->tid);
+        free(pool->queue);
+        free(pool);
+        return 0;
+    }
+    pthread_mutex_init(&pool->busy, 0);
+    pthread_mutex_init(&pool->lock, 0);
+    pthread_cond_init(&pool->start, 0);
+    pthread_cond_init(&pool->done, 0);
+    for (i = 0; i <= threads; i++) {
+        pthread_mutex_init(&pool->queue[i].lock, 0);
+        pool->queue[i].next = pool->queue[i].end = 0;
+    }
+
+    /* Fewer threads than asked for is still a working pool */
+    for (i = 0; i < threads; i++) {
+        w = (struct _huffman_pool_worker *)malloc(sizeof(*w));
+        if (!w) break;
+        w->pool = pool;
+        w->self = i;
+        if (pthread_create(&pool->tid[i], 0, huffman_pool_main, w)) {
+            free(w);
+            break;
+        }
+    }
+    pool->threads = i;
+    return pool;
+}
+
+void huffman_pool_destroy(struct huffman_pool *pool) {
+    int i = 0;
+
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i < pool->threads; i++) pthread_join(pool->tid[i], 0);
+    for (i = 0; i <= pool->threads; i++) pthread_mutex_destroy(&pool->queue[i].lock);
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->busy);
+    free(pool->queue);
+    free(pool->tid);
+    free(pool);
+}
+
+/*
+ * Runs 'run' for blocks 0 to 'blocks' - 1 on the pool's workers and the
+ * calling thread, and returns the first error any of them hit.  Without
+ * a pool the caller runs every block itself.
+ */
+static int huffman_pool_run( struct huffman_pool *pool, int (*run)( void *arg, int block ), void *arg, int blocks ) {
+    struct _huffman_pool_job job = { run, arg, 0 };
+    int i = 0, n = 0, rc = 0;
+
+    if (!pool || !pool->threads || blocks < 2) {
+        for (i = 0; i < blocks; i++) {
+            rc = run(arg, i);
+            if (rc < 0 && !job.error) job.error = rc;
+        }
+        return job.error;
+    }
+
+    pthread_mutex_lock(&pool->busy);
+    n = pool->threads + 1;
+    for (i = 0; i < n; i++) {
+        pthread_mutex_lock(&pool->queue[i].lock);
+        pool->queue[i].next = (int)((int64_t)blocks * i / n);
+        pool->queue[i].end = (int)((int64_t)blocks * (i + 1) / n);
+        pthread_mutex_unlock(&pool->queue[i].lock);
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->job = &job;
+    pool->active = pool->threads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    huffman_pool_work(pool, &job, pool->threads);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active) pthread_cond_wait(&pool->done, &pool->lock);
+    pool->job = 0;
+    rc = job.error;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->busy);
+    return rc;
+}
+
+/******** Frames ********/
+
+static inline uint32_t huffman_frame_get32( const uint8_t *p ) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void huffman_frame_put32( uint8_t *p, uint32_t v ) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* What the block callbacks share; 'ends' holds each block's code end */
+struct _huffman_frame_job {
+    const struct huffman_codebook *cb;
+    const uint8_t *input;
+    int inlen;
+    int block_size;
+    int *ends;
+    const uint8_t *code;                        /* Start of the code area */
+    uint8_t *out;
+    char *text;
+};
+
+static int huffman_frame_code( const struct huffman_codebook *cb, const uint8_t *input, int inlen, uint8_t *output, int outcap ) {
+    return cb ? huffman_codebook_encode(cb, input, inlen, output, outcap) : huffman_encode(input, inlen, output, outcap);
+}
+
+static int huffman_frame_decode_code( const struct huffman_codebook *cb, const uint8_t *input, int inlen, char *output, int outcap ) {
+    return cb ? huffman_codebook_decode(cb, input, inlen, output, outcap) : huffman_decode(input, inlen, output, outcap);
+}
+
+static inline int huffman_frame_block_len( const struct _huffman_frame_job *j, int block ) {
+    int start = block * j->block_size;
+
+    return (j->inlen - start < j->block_size) ? j->inlen - start : j->block_size;
+}
+
+/* Pass 1: the coded length of each block */
+static int huffman_frame_measure( void *arg, int block ) {
+    struct _huffman_frame_job *j = (struct _huffman_frame_job *)arg;
+
+    j->ends[block] = huffman_frame_code(j->cb, j->input + (size_t)block * j->block_size, huffman_frame_block_len(j, block), 0, 0);
+    return j->ends[block];
+}
+
+/* Pass 2: code each block into its place */
+static int huffman_frame_encode_block( void *arg, int block ) {
+    struct _huffman_frame_job *j = (struct _huffman_frame_job *)arg;
+    int start = block ? j->ends[block-1] : 0;
+
+    return huffman_frame_code(j->cb, j->input + (size_t)block * j->block_size, huffman_frame_block_len(j, block), j->out + start, j->ends[block] - start);
+}
+
+int huffman_frame_encode(struct huffman_pool *pool, const struct huffman_codebook *cb, const uint8_t *input, int inlen, int block_size, uint8_t *output, int outcap) {
+    struct _huffman_frame_job j;
+    int64_t total = 0;
+    int blocks = 0, i = 0, rc = 0;
+
+    if (inlen < 0 || (!input && inlen) || block_size <= 0 || outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    blocks = (int)(((int64_t)inlen + block_size - 1) / block_size);
+    huffman_zero_mem(&j, sizeof(j));
+    j.cb = cb;
+    j.input = input;
+    j.inlen = inlen;
+    j.block_size = block_size;
+    j.ends = (int *)malloc((blocks ? blocks : 1) * sizeof(int));
+    if (!j.ends) return HUFFMAN_STAT_FAIL(HUFFMAN_NO_MEMORY);
+
+    rc = huffman_pool_run(pool, huffman_frame_measure, &j, blocks);
+    total = HUFFMAN_FRAME_HEADER + (int64_t)blocks * HUFFMAN_FRAME_ENTRY;
+    for (i = 0; i < blocks && rc >= 0; i++) {
+        total += j.ends[i];
+        j.ends[i] = (int)(total - HUFFMAN_FRAME_HEADER - (int64_t)blocks * HUFFMAN_FRAME_ENTRY);
+        if (total > INT32_MAX) rc = HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    }
+    if (rc < 0 || !output || total > outcap) {
+        free(j.ends);
+        return (rc < 0) ? rc : (int)total;
+    }
+
+    huffman_frame_put32(output, HUFFMAN_FRAME_MAGIC);
+    huffman_frame_put32(output + 4, (uint32_t)block_size);
+    huffman_frame_put32(output + 8, (uint32_t)blocks);
+    for (i = 0; i < blocks; i++) {
+        huffman_frame_put32(output + HUFFMAN_FRAME_HEADER + i * HUFFMAN_FRAME_ENTRY, (uint32_t)j.ends[i]);
+        huffman_frame_put32(output + HUFFMAN_FRAME_HEADER + i * HUFFMAN_FRAME_ENTRY + 4, (uint32_t)huffman_frame_block_len(&j, i));
+    }
+    j.out = output + HUFFMAN_FRAME_HEADER + (size_t)blocks * HUFFMAN_FRAME_ENTRY;
+    rc = huffman_pool_run(pool, huffman_frame_encode_block, &j, blocks);
+    free(j.ends);
+    return (rc < 0) ? rc : (int)total;
+}
+
+/*
+ * Checks the header and that the index fits.  Block 'k' lies in the code
+ * area from the end of block k - 1 to its own end; huffman_frame_entry()
+ * checks those when the block is used, so reading one block costs the
+ * same however many there are.
+ */
+static int huffman_frame_header( const uint8_t *input, int inlen, int *block_size, int *blocks ) {
+    if (!input || inlen < HUFFMAN_FRAME_HEADER || huffman_frame_get32(input) != HUFFMAN_FRAME_MAGIC) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    *block_size = (int)huffman_frame_get32(input + 4);
+    *blocks = (int)huffman_frame_get32(input + 8);
+    if (*block_size <= 0 || *blocks < 0 || (int64_t)*blocks * HUFFMAN_FRAME_ENTRY > inlen - HUFFMAN_FRAME_HEADER) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    if ((int64_t)*blocks * *block_size - *block_size >= INT32_MAX) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    return HUFFMAN_SUCCESS;
+}
+
+/* Finds block 'k': its code and original length */
+static int huffman_frame_entry( const uint8_t *input, int inlen, int block_size, int blocks, int k, const uint8_t **code, int *codelen, int *length ) {
+    const uint8_t *index = input + HUFFMAN_FRAME_HEADER;
+    int area = inlen - HUFFMAN_FRAME_HEADER - blocks * HUFFMAN_FRAME_ENTRY;
+    uint32_t start = k ? huffman_frame_get32(index + (k - 1) * HUFFMAN_FRAME_ENTRY) : 0;
+    uint32_t end = huffman_frame_get32(index + k * HUFFMAN_FRAME_ENTRY);
+    uint32_t len = huffman_frame_get32(index + k * HUFFMAN_FRAME_ENTRY + 4);
+
+    /* Every block but the last is exactly 'block_size' long */
+    if (start > end || end > (uint32_t)area || len > (uint32_t)block_size || (k < blocks - 1 && len != (uint32_t)block_size)) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    *code = index + blocks * HUFFMAN_FRAME_ENTRY + start;
+    *codelen = (int)(end - start);
+    *length = (int)len;
+    return HUFFMAN_SUCCESS;
+}
+
+int huffman_frame_info(const uint8_t *input, int inlen, struct huffman_frame_info *info) {
+    const uint8_t *code = 0;
+    int block_size = 0, blocks = 0, codelen = 0, length = 0, rc = 0;
+
+    if (!info) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    rc = huffman_frame_header(input, inlen, &block_size, &blocks);
+    if (rc < 0) return rc;
+    if (blocks) {
+        rc = huffman_frame_entry(input, inlen, block_size, blocks, blocks - 1, &code, &codelen, &length);
+        if (rc < 0) return rc;
+        if ((int64_t)(blocks - 1) * block_size + length > INT32_MAX) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    }
+    info->blocks = blocks;
+    info->block_size = block_size;
+    info->length = blocks ? (blocks - 1) * block_size + length : 0;
+    info->frame_length = blocks ? (int)(code - input) + codelen : HUFFMAN_FRAME_HEADER;
+    return HUFFMAN_SUCCESS;
+}
+
+int huffman_frame_decode_block(const struct huffman_codebook *cb, const uint8_t *input, int inlen, int block, char *output, int outcap) {
+    const uint8_t *code = 0;
+    int block_size = 0, blocks = 0, codelen = 0, length = 0, rc = 0;
+
+    if (outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    rc = huffman_frame_header(input, inlen, &block_size, &blocks);
+    if (rc < 0) return rc;
+    if (block < 0 || block >= blocks) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    rc = huffman_frame_entry(input, inlen, block_size, blocks, block, &code, &codelen, &length);
+    if (rc < 0) return rc;
+    if (!output || length > outcap) return length;
+    if (huffman_frame_decode_code(cb, code, codelen, output, length) != length) return HUFFMAN_STAT_FAIL(HUFFMAN_FRAME_INVALID);
+    return length;
+}
+
+/* Decodes one block in place within the whole output */
+static int huffman_frame_decode_one( void *arg, int block ) {
+    struct _huffman_frame_job *j = (struct _huffman_frame_job *)arg;
+
+    return huffman_frame_decode_block(j->cb, j->input, j->inlen, block, j->text + (size_t)block * j->block_size, j->block_size);
+}
+
+int huffman_frame_decode(struct huffman_pool *pool, const struct huffman_codebook *cb, const uint8_t *input, int inlen, char *output, int outcap) {
+    struct huffman_frame_info info;
+    struct _huffman_frame_job j;
+    int rc = 0;
+
+    if (outcap < 0) return HUFFMAN_STAT_FAIL(HUFFMAN_BAD_PARAMETER);
+    huffman_zero_mem(&info, sizeof(info));
+    rc = huffman_frame_info(input, inlen, &info);
+    if (rc < 0) return rc;
+    if (!output || info.length > outcap) return info.length;
+
+    huffman_zero_mem(&j, sizeof(j));
+    j.cb = cb;
+    j.input = input;
+    j.inlen = inlen;
+    j.block_size = info.block_size;
+    j.text = output;
+    rc = huffman_pool_run(pool, huffman_frame_decode_one, &j, info.blocks);
+    return (rc < 0) ? rc : info.length;
+}
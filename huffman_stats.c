@@ -0,0 +1,179 @@
+/*
+ * File:   huffman_stats.c
+ *
+ * Per-thread counters behind huffman_get_stats().  Each thread bumps its
+ * own block without locking; the blocks are linked into a list that
+ * huffman_get_stats() sums on demand, and a thread's counts are folded
+ * into a retired total when it exits.
+ */
+
+#include "huffman_stats.h"
+
+#ifdef HUFFMAN_STATS
+
+#include <pthread.h>
+#if defined(__x86_64__) || defined(__i386__)
+#define HUFFMAN_STATS_USE_RDTSC 1
+#include <x86intrin.h>
+#else
+#define HUFFMAN_STATS_USE_RDTSC 0
+#include <time.h>
+#endif
+
+#define HUFFMAN_STATS_FIELDS ((int)(sizeof(struct huffman_stats) / sizeof(uint64_t)))
+
+struct _huffman_stats_block {
+    struct huffman_stats s;
+    struct _huffman_stats_block *next;
+    int registered;
+};
+
+static pthread_mutex_t huffman_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t huffman_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t huffman_stats_key;
+static struct _huffman_stats_block *huffman_stats_threads = 0;
+static struct huffman_stats huffman_stats_retired;
+static struct huffman_stats huffman_stats_baseline;
+static __thread struct _huffman_stats_block huffman_stats_tls;
+
+/*
+ * Only the owning thread writes a counter, but huffman_get_stats() reads
+ * it from another thread, so both sides go through relaxed atomics.
+ */
+#define HUFFMAN_STATS_BUMP(field, n) __atomic_store_n(&(field), (field) + (uint64_t)(n), __ATOMIC_RELAXED)
+
+static void huffman_stats_add( struct huffman_stats *to, const struct huffman_stats *from ) {
+    uint64_t *t = (uint64_t *)to;
+    const uint64_t *f = (const uint64_t *)from;
+    int i = 0;
+
+    for (i = 0; i < HUFFMAN_STATS_FIELDS; i++) t[i] += __atomic_load_n(&f[i], __ATOMIC_RELAXED);
+}
+
+static void huffman_stats_thread_exit( void *arg ) {
+    struct _huffman_stats_block *b = (struct _huffman_stats_block *)arg, **p = 0;
+
+    pthread_mutex_lock(&huffman_stats_lock);
+    huffman_stats_add(&huffman_stats_retired, &b->s);
+    for (p = &huffman_stats_threads; *p; p = &(*p)->next) {
+        if (*p == b) {
+            *p = b->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&huffman_stats_lock);
+}
+
+static void huffman_stats_make_key( void ) {
+    pthread_key_create(&huffman_stats_key, &huffman_stats_thread_exit);
+}
+
+static struct huffman_stats *huffman_stats_local( void ) {
+    struct _huffman_stats_block *b = &huffman_stats_tls;
+
+    if (!b->registered) {
+        pthread_once(&huffman_stats_once, &huffman_stats_make_key);
+        pthread_mutex_lock(&huffman_stats_lock);
+        b->next = huffman_stats_threads;
+        huffman_stats_threads = b;
+        pthread_mutex_unlock(&huffman_stats_lock);
+        pthread_setspecific(huffman_stats_key, b);
+        b->registered = 1;
+    }
+    return &b->s;
+}
+
+void huffman_stats_encoded( const uint8_t *input, int inlen, int outlen ) {
+    struct huffman_stats *s = huffman_stats_local();
+    int i = 0;
+
+    HUFFMAN_STATS_BUMP(s->encode_calls, 1);
+    HUFFMAN_STATS_BUMP(s->encode_bytes_in, inlen);
+    HUFFMAN_STATS_BUMP(s->encode_bytes_out, outlen);
+    for (i = 0; i < inlen; i++) HUFFMAN_STATS_BUMP(s->code_lengths[hpack_table[input[i]].bits], 1);
+}
+
+/*
+ * The decoded octets give the code lengths back through hpack_table, so
+ * the histogram costs nothing inside the decode loop.
+ */
+void huffman_stats_decoded( const char *output, int outlen, int inlen, int strings ) {
+    struct huffman_stats *s = huffman_stats_local();
+    int i = 0;
+
+    HUFFMAN_STATS_BUMP(s->decode_calls, strings);
+    HUFFMAN_STATS_BUMP(s->decode_bytes_in, inlen);
+    HUFFMAN_STATS_BUMP(s->decode_bytes_out, outlen);
+    for (i = 0; i < outlen; i++) HUFFMAN_STATS_BUMP(s->code_lengths[hpack_table[(uint8_t)output[i]].bits], 1);
+}
+
+int huffman_stats_error( int code ) {
+    struct huffman_stats *s = huffman_stats_local();
+
+    if (code < 0 && -code < HUFFMAN_STATS_ERRORS) HUFFMAN_STATS_BUMP(s->errors[-code], 1);
+    return code;
+}
+
+void huffman_stats_alloc( int realloced ) {
+    struct huffman_stats *s = huffman_stats_local();
+
+    if (realloced) HUFFMAN_STATS_BUMP(s->reallocations, 1);
+    else HUFFMAN_STATS_BUMP(s->allocations, 1);
+}
+
+uint64_t huffman_stats_clock( void ) {
+#if HUFFMAN_STATS_USE_RDTSC
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void huffman_stats_cycles( int decoding, uint64_t cycles ) {
+    struct huffman_stats *s = huffman_stats_local();
+
+    if (decoding) HUFFMAN_STATS_BUMP(s->decode_cycles, cycles);
+    else HUFFMAN_STATS_BUMP(s->encode_cycles, cycles);
+}
+
+int huffman_get_stats(struct huffman_stats *stats) {
+    struct _huffman_stats_block *b = 0;
+    uint64_t *t = (uint64_t *)stats;
+    const uint64_t *base = (const uint64_t *)&huffman_stats_baseline;
+    int i = 0;
+
+    if (!stats) return HUFFMAN_BAD_PARAMETER;
+    memset(stats, 0, sizeof(*stats));
+    pthread_mutex_lock(&huffman_stats_lock);
+    huffman_stats_add(stats, &huffman_stats_retired);
+    for (b = huffman_stats_threads; b; b = b->next) huffman_stats_add(stats, &b->s);
+    for (i = 0; i < HUFFMAN_STATS_FIELDS; i++) t[i] -= base[i];
+    pthread_mutex_unlock(&huffman_stats_lock);
+    return HUFFMAN_SUCCESS;
+}
+
+void huffman_reset_stats( void ) {
+    struct _huffman_stats_block *b = 0;
+
+    /* Other threads own their counters, so reset moves the zero point instead */
+    pthread_mutex_lock(&huffman_stats_lock);
+    memset(&huffman_stats_baseline, 0, sizeof(huffman_stats_baseline));
+    huffman_stats_add(&huffman_stats_baseline, &huffman_stats_retired);
+    for (b = huffman_stats_threads; b; b = b->next) huffman_stats_add(&huffman_stats_baseline, &b->s);
+    pthread_mutex_unlock(&huffman_stats_lock);
+}
+
+#else
+
+int huffman_get_stats(struct huffman_stats *stats) {
+    if (!stats) return HUFFMAN_BAD_PARAMETER;
+    memset(stats, 0, sizeof(*stats));
+    return HUFFMAN_NO_ERROR;
+}
+
+void huffman_reset_stats( void ) {
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* 
+ * File:   huffman_stats.h
+ *
+ * Internal instrumentation hooks for huffman.c.  With HUFFMAN_STATS
+ * defined they feed the per-thread counters behind huffman_get_stats();
+ * without it every hook expands to nothing (HUFFMAN_STAT_FAIL() to its
+ * argument), so the coding loops compile exactly as before.
+ * HUFFMAN_STATS_CYCLES additionally times each call with the CPU's cycle
+ * counter.
+ */
+
+#ifndef HUFFMAN_STATS_H
+#define HUFFMAN_STATS_H
+
+#include "huffman.h"
+
+#ifdef HUFFMAN_STATS
+
+void huffman_stats_encoded( const uint8_t *input, int inlen, int outlen );
+void huffman_stats_decoded( const char *output, int outlen, int inlen, int strings );
+int huffman_stats_error( int code );
+void huffman_stats_alloc( int realloced );
+uint64_t huffman_stats_clock( void );
+void huffman_stats_cycles( int decoding, uint64_t cycles );
+
+#define HUFFMAN_STAT_ENCODED(input, inlen, outlen)          huffman_stats_encoded((input), (inlen), (outlen))
+#define HUFFMAN_STAT_DECODED(output, outlen, inlen, strings) huffman_stats_decoded((output), (outlen), (inlen), (strings))
+#define HUFFMAN_STAT_FAIL(code)                             huffman_stats_error(code)
+#define HUFFMAN_STAT_ALLOC()                                huffman_stats_alloc(0)
+#define HUFFMAN_STAT_REALLOC()                              huffman_stats_alloc(1)
+
+#else
+
+#define HUFFMAN_STAT_ENCODED(input, inlen, outlen)          do { } while (0)
+#define HUFFMAN_STAT_DECODED(output, outlen, inlen, strings) do { } while (0)
+#define HUFFMAN_STAT_FAIL(code)                             (code)
+#define HUFFMAN_STAT_ALLOC()                                do { } while (0)
+#define HUFFMAN_STAT_REALLOC()                              do { } while (0)
+
+#endif
+
+#if defined(HUFFMAN_STATS) && defined(HUFFMAN_STATS_CYCLES)
+#define HUFFMAN_STAT_TIMER(t)                               uint64_t t = huffman_stats_clock()
+#define HUFFMAN_STAT_ENCODE_TIME(t)                         huffman_stats_cycles(0, huffman_stats_clock() - (t))
+#define HUFFMAN_STAT_DECODE_TIME(t)                         huffman_stats_cycles(1, huffman_stats_clock() - (t))
+#else
+#define HUFFMAN_STAT_TIMER(t)                               do { } while (0)
+#define HUFFMAN_STAT_ENCODE_TIME(t)                         do { } while (0)
+#define HUFFMAN_STAT_DECODE_TIME(t)                         do { } while (0)
+#endif
+
+#endif /* HUFFMAN_STATS_H */
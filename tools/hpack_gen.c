@@ -0,0 +1,112 @@
+/*
+ * File:   hpack_gen.c
+ *
+ * Generates hpack_static_table.h: the HPACK static table from
+ * hpack_static.inc with its string lengths, and the hash indexes hpack.c
+ * looks names and fields up in.  They are laid out here, at build time,
+ * so an encoder needs no first-use setup and the indexes are read-only.
+ * hpack_build.h holds the hash, so the slots match what hpack.c computes.
+ *
+ *      cc -o hpack_gen tools/hpack_gen.c && ./hpack_gen > hpack_static_table.h
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../hpack_build.h"
+
+static const struct {
+    const char *name;
+    const char *value;
+} rows[] = {
+#include "../hpack_static.inc"
+};
+
+static struct _hpack_static_entry table[HPACK_STATIC_ENTRIES];
+static struct _hpack_slot names[HPACK_STATIC_INDEX_SIZE];
+static struct _hpack_slot fields[HPACK_STATIC_INDEX_SIZE];
+
+static int same( const char *a, int alen, const char *b, int blen ) {
+    return alen == blen && !memcmp(a, b, alen);
+}
+
+/* Entries go in from the last, so a name keeps its lowest index */
+static void add( struct _hpack_slot *slots, uint32_t hash, int idx, int by_name ) {
+    const struct _hpack_static_entry *e = &table[idx-1], *o = 0;
+    struct _hpack_slot *sl = 0;
+    uint32_t i = 0;
+
+    for (i = hash; ; i++) {
+        sl = &slots[i & (HPACK_STATIC_INDEX_SIZE - 1)];
+        if (!sl->hash) break;
+        o = &table[sl->seq - 1];
+        if (sl->hash == hash && same(o->name, o->namelen, e->name, e->namelen)
+                && (by_name || same(o->value, o->valuelen, e->value, e->valuelen))) break;
+    }
+    sl->hash = hash;
+    sl->seq = (uint64_t)idx;
+}
+
+/* The strings are plain ASCII without quotes or backslashes */
+static int printable( const char *s ) {
+    for (; *s; s++) {
+        if (*s < 0x20 || *s > 0x7e || *s == '"' || *s == '\\') return 0;
+    }
+    return 1;
+}
+
+static void print_index( const char *name, const struct _hpack_slot *slots ) {
+    int i = 0;
+
+    printf("static const struct _hpack_slot %s[HPACK_STATIC_INDEX_SIZE] = {\n", name);
+    for (i = 0; i < HPACK_STATIC_INDEX_SIZE; i++) {
+        printf("%s{%llu,0x%08lx,0}%s", (i % 4) ? " " : "    ", (unsigned long long)slots[i].seq, (unsigned long)slots[i].hash,
+               (i == HPACK_STATIC_INDEX_SIZE - 1) ? "\n" : ((i % 4) == 3 ? ",\n" : ","));
+    }
+    printf("};\n");
+}
+
+int main( void ) {
+    uint32_t h = 0;
+    int i = 0;
+
+    if (sizeof(rows) / sizeof(rows[0]) != HPACK_STATIC_ENTRIES) {
+        fprintf(stderr, "hpack_gen: hpack_static.inc has %d rows, not %d\n", (int)(sizeof(rows) / sizeof(rows[0])), HPACK_STATIC_ENTRIES);
+        return 1;
+    }
+    for (i = 0; i < HPACK_STATIC_ENTRIES; i++) {
+        if (!printable(rows[i].name) || !printable(rows[i].value)) {
+            fprintf(stderr, "hpack_gen: row %d needs escaping\n", i + 1);
+            return 1;
+        }
+        table[i].name = rows[i].name;
+        table[i].value = rows[i].value;
+        table[i].namelen = (int)strlen(rows[i].name);
+        table[i].valuelen = (int)strlen(rows[i].value);
+    }
+    for (i = HPACK_STATIC_ENTRIES; i >= 1; i--) {
+        h = hpack_hash((const uint8_t *)table[i-1].name, table[i-1].namelen, 0);
+        add(names, h, i, 1);
+        h = hpack_hash((const uint8_t *)table[i-1].value, table[i-1].valuelen, h);
+        add(fields, h, i, 0);
+    }
+
+    printf("/*\n");
+    printf(" * Generated by tools/hpack_gen.c from hpack_static.inc.  Do not edit.\n");
+    printf(" *\n");
+    printf(" * The static table with {name, value, name length, value length}, and\n");
+    printf(" * its indexes by name and by name + value: open addressing over %d\n", HPACK_STATIC_INDEX_SIZE);
+    printf(" * slots of {static index, hash, 0}, the lowest index winning ties.\n");
+    printf(" */\n\n");
+    printf("static const struct _hpack_static_entry hpack_static[HPACK_STATIC_ENTRIES] = {\n");
+    for (i = 0; i < HPACK_STATIC_ENTRIES; i++) {
+        printf("    { \"%s\", \"%s\", %d, %d }%s\n", table[i].name, table[i].value, table[i].namelen, table[i].valuelen,
+               (i == HPACK_STATIC_ENTRIES - 1) ? "" : ",");
+    }
+    printf("};\n\n");
+    print_index("hpack_static_names", names);
+    printf("\n");
+    print_index("hpack_static_fields", fields);
+    return 0;
+}
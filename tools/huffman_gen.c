@@ -0,0 +1,50 @@
+/* 
+ * File:   huffman_gen.c
+ *
+ * Generates huffman_decode_table.h, the multi-level decode table for the
+ * HPACK code in hpack_table.inc.  The table is laid out here, at build
+ * time, so the library needs no initialization and keeps exactly one
+ * read-only copy of it.  huffman_build.c does the layout, the same way it
+ * does for trained codebooks at run time.
+ *
+ *      cc -o huffman_gen tools/huffman_gen.c huffman_build.c && ./huffman_gen > huffman_decode_table.h
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../huffman_build.h"
+
+static const struct _hpack_table codes[HPACK_SIZE] = {
+#include "../hpack_table.inc"
+};
+
+int main( void ) {
+    struct _huffman_decode_entry *tbl = 0;
+    int entries = 0, i = 0;
+    
+    entries = huffman_build_decode_table(codes, 0);
+    tbl = (struct _huffman_decode_entry *)calloc(entries, sizeof(struct _huffman_decode_entry));
+    if (!tbl) {
+        fprintf(stderr, "huffman_gen: out of memory\n");
+        return 1;
+    }
+    huffman_build_decode_table(codes, tbl);
+    
+    printf("/*\n");
+    printf(" * Generated by tools/huffman_gen.c from hpack_table.inc.  Do not edit.\n");
+    printf(" *\n");
+    printf(" * Multi-level decode table: %d-bit root, sub-tables of up to %d bits.\n", HUFFMAN_DECODE_ROOT_BITS, HUFFMAN_DECODE_SUB_BITS);
+    printf(" * Entries are {symbol or sub-table offset, code length or sub-table\n");
+    printf(" * width, flags}.\n");
+    printf(" */\n\n");
+    printf("#define HUFFMAN_DECODE_TABLE_SIZE %d\n\n", entries);
+    printf("static const struct _huffman_decode_entry huffman_decode_table[HUFFMAN_DECODE_TABLE_SIZE] = {\n");
+    for (i = 0; i < entries; i++) {
+        printf("%s{%d,%d,%d}%s", (i % 8) ? " " : "    ", tbl[i].next, tbl[i].bits, tbl[i].flags, (i == entries - 1) ? "\n" : ((i % 8) == 7 ? ",\n" : ","));
+    }
+    printf("};\n");
+    free(tbl);
+    return 0;
+}